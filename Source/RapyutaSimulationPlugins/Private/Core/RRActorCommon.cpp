@@ -284,3 +284,41 @@ bool URRActorCommon::HasInitialized(bool bIsLogged) const
 
     return true;
 }
+
+uint32 URRActorCommon::RegisterInstanceIdEntity(ARRMeshActor* InEntity)
+{
+    uint32 instanceId = INSTANCE_ID_VOID;
+    if (FreeInstanceIds.Num() > 0)
+    {
+        instanceId = FreeInstanceIds.Pop(false);
+    }
+    else if (LatestInstanceId < MAX_INSTANCE_ID)
+    {
+        instanceId = ++LatestInstanceId;
+    }
+    else
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore,
+                         Error,
+                         TEXT("SceneInstance[%d] More than %u instance ids being in use!"),
+                         SceneInstanceId,
+                         MAX_INSTANCE_ID);
+        return INSTANCE_ID_VOID;
+    }
+    InstanceIdEntityTable.Add(instanceId, InEntity);
+    return instanceId;
+}
+
+void URRActorCommon::UnregisterInstanceIdEntity(uint32 InInstanceId, const ARRMeshActor* InEntity)
+{
+    if ((INSTANCE_ID_VOID != InInstanceId) && (InEntity == GetEntityByInstanceId(InInstanceId)))
+    {
+        InstanceIdEntityTable.Remove(InInstanceId);
+        FreeInstanceIds.Add(InInstanceId);
+    }
+}
+
+ARRMeshActor* URRActorCommon::GetEntityByInstanceId(uint32 InInstanceId) const
+{
+    return InstanceIdEntityTable.FindRef(InInstanceId).Get();
+}
@@ -5,10 +5,12 @@
 // UE
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "Kismet/GameplayStatics.h"
 
 // RapyutaSimInternal
 #include "Core/RRActorCommon.h"
 #include "Core/RRCoreUtils.h"
+#include "Core/RRCrowdSignificanceManager.h"
 #include "Core/RRMathUtils.h"
 #include "Core/RRMeshActor.h"
 #include "Core/RRUObjectUtils.h"
@@ -20,6 +22,20 @@ ARRCamera::ARRCamera()
     SetRootComponent(CameraComponent);
 }
 
+FMatrix ARRCamera::GetViewProjectionMatrix(const FIntPoint& InImageSize) const
+{
+    FMinimalViewInfo viewInfo;
+    CameraComponent->GetCameraView(0.f, viewInfo);
+    if ((InImageSize.X > 0) && (InImageSize.Y > 0))
+    {
+        viewInfo.AspectRatio = float(InImageSize.X) / InImageSize.Y;
+    }
+
+    FMatrix viewMatrix, projectionMatrix, viewProjectionMatrix;
+    UGameplayStatics::GetViewProjectionMatrix(viewInfo, viewMatrix, projectionMatrix, viewProjectionMatrix);
+    return viewProjectionMatrix;
+}
+
 void ARRCamera::PrintSimConfig() const
 {
     Super::PrintSimConfig();
@@ -35,6 +51,13 @@ bool ARRCamera::Initialize()
         return false;
     }
     RandomizeFoV();
+
+    // Crowd agents in view of this camera are significant
+    auto* significanceManager = GetWorld()->GetSubsystem<URRCrowdSignificanceManager>();
+    if (significanceManager)
+    {
+        significanceManager->RegisterObserver(this);
+    }
     return true;
 }
 
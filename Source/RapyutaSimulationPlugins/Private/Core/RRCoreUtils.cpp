@@ -2,11 +2,16 @@
 #include "Core/RRCoreUtils.h"
 
 // UE
+#include "Async/ParallelFor.h"
 #include "CoreMinimal.h"
 #include "Engine/GameViewportClient.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformProcess.h"
 #include "IESConverter.h"
 #include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/Archive.h"
 
 // RapyutaSimulationPlugins
 #include "Core/RRActorCommon.h"
@@ -23,13 +28,8 @@
 
 IImageWrapperModule* URRCoreUtils::SImageWrapperModule = nullptr;
 TMap<ERRFileType, TSharedPtr<IImageWrapper>> URRCoreUtils::SImageWrappers;
-FRRLightProfileData URRCoreUtils::SLightProfileData;
-TFunction<void(uint8*, const FUpdateTextureRegion2D*)> URRCoreUtils::CleanupLightProfileData =
-    [](uint8*, const FUpdateTextureRegion2D*)
-{
-    FMemory::Free(SLightProfileData.ImageData);
-    SLightProfileData.ImageData = nullptr;
-};
+bool URRCoreUtils::SImageCacheEnabled = true;
+TMap<FString, FRRCachedLightProfile> URRCoreUtils::SLightProfileCache;
 
 FString URRCoreUtils::GetFileTypeFilter(const ERRFileType InFileType)
 {
@@ -289,6 +289,108 @@ bool URRCoreUtils::CheckWithTimeOut(const TFunctionRef<bool()>& InCondition,
 // -------------------------------------------------------------------------------------------------------------------------
 // IMAGE UTILS --
 //
+bool URRCoreUtils::DecodeImageFile(const FString& InFullFilePath, FRRDecodedImageData& OutImageData)
+{
+    TArray<uint8> fileData;
+    if (!(FFileHelper::LoadFileToArray(fileData, *InFullFilePath) && fileData.Num() > 0))
+    {
+        return false;
+    }
+
+    // 1- Try the on-disk cache, keyed by file content hash so that renamed/moved images are still hit & edited ones are not
+    FString cacheFilePath;
+    if (SImageCacheEnabled)
+    {
+        cacheFilePath = GetImageCacheFolderPath() / FSHA1::HashBuffer(fileData.GetData(), fileData.Num()).ToString();
+        TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*cacheFilePath, FILEREAD_Silent));
+        if (reader)
+        {
+            uint32 magic = 0;
+            *reader << magic;
+            *reader << OutImageData.Width;
+            *reader << OutImageData.Height;
+            // Reject a corrupted/truncated entry, whose pixel data size does not match its header
+            const int64 dataSize = int64(OutImageData.Width) * OutImageData.Height * 4;
+            if ((false == reader->IsError()) && (IMAGE_CACHE_FILE_MAGIC == magic) && (OutImageData.Width > 0) &&
+                (OutImageData.Height > 0) && (dataSize == (reader->TotalSize() - reader->Tell())))
+            {
+                OutImageData.BGRAData.SetNumUninitialized(dataSize);
+                reader->Serialize(OutImageData.BGRAData.GetData(), OutImageData.BGRAData.Num());
+                if ((false == reader->IsError()) && OutImageData.IsValid())
+                {
+                    return true;
+                }
+            }
+            OutImageData = FRRDecodedImageData();
+        }
+    }
+
+    // 2- Decompress, with a wrapper per call since [SImageWrappers] are not thread-safe
+    const EImageFormat imageFormat = SImageWrapperModule->DetectImageFormat(fileData.GetData(), fileData.Num());
+    if (EImageFormat::Invalid == imageFormat)
+    {
+        return false;
+    }
+    TSharedPtr<IImageWrapper> imageWrapper = SImageWrapperModule->CreateImageWrapper(imageFormat);
+    if (!(imageWrapper.IsValid() && imageWrapper->SetCompressed(fileData.GetData(), fileData.Num())))
+    {
+        return false;
+    }
+    // 16-bit & float images are left to LoadImageToTexture(), which keeps their precision (eg PF_FloatRGBA)
+    // instead of them being truncated to 8-bit here
+    if ((URRActorCommon::IMAGE_BIT_DEPTH_INT8 != imageWrapper->GetBitDepth()) ||
+        (false == imageWrapper->GetRaw(ERGBFormat::BGRA, URRActorCommon::IMAGE_BIT_DEPTH_INT8, OutImageData.BGRAData)))
+    {
+        return false;
+    }
+    OutImageData.Width = imageWrapper->GetWidth();
+    OutImageData.Height = imageWrapper->GetHeight();
+    if (false == OutImageData.IsValid())
+    {
+        return false;
+    }
+
+    // 3- Save to the cache, via a temp file so that concurrent loaders never read a partial one
+    if (SImageCacheEnabled)
+    {
+        const FString tempFilePath = FString::Printf(TEXT("%s.%s.tmp"), *cacheFilePath, *FGuid::NewGuid().ToString());
+        TUniquePtr<FArchive> writer(IFileManager::Get().CreateFileWriter(*tempFilePath, FILEWRITE_Silent));
+        if (writer)
+        {
+            uint32 magic = IMAGE_CACHE_FILE_MAGIC;
+            *writer << magic;
+            *writer << OutImageData.Width;
+            *writer << OutImageData.Height;
+            writer->Serialize(OutImageData.BGRAData.GetData(), OutImageData.BGRAData.Num());
+            const bool bWritten = writer->Close();
+            writer.Reset();
+            if (!(bWritten && IFileManager::Get().Move(*cacheFilePath, *tempFilePath, true, true, false, true)))
+            {
+                IFileManager::Get().Delete(*tempFilePath, false, false, true);
+            }
+        }
+    }
+    return true;
+}
+
+UTexture2D* URRCoreUtils::CreateTextureFromImageData(const FRRDecodedImageData& InImageData, const FString& InTextureName)
+{
+    check(IsInGameThread());
+    UTexture2D* texture = UTexture2D::CreateTransient(InImageData.Width, InImageData.Height, PF_B8G8R8A8);
+    if (nullptr == texture)
+    {
+        return nullptr;
+    }
+
+    FTexture2DMipMap& mip = texture->GetPlatformData()->Mips[0];
+    void* mipData = mip.BulkData.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(mipData, InImageData.BGRAData.GetData(), InImageData.BGRAData.Num());
+    mip.BulkData.Unlock();
+    texture->UpdateResource();
+    texture->Rename(*InTextureName);
+    return texture;
+}
+
 bool URRCoreUtils::LoadImagesFromFolder(const FString& InImageFolderPath,
                                         const TArray<ERRFileType>& InImageFileTypes,
                                         TArray<UTexture*>& OutImageTextureList,
@@ -299,20 +401,45 @@ bool URRCoreUtils::LoadImagesFromFolder(const FString& InImageFolderPath,
 
     if (bResult)
     {
-        for (const auto& imagePath : imageFilePaths)
+        // Module loading must be on game thread
+        LoadImageWrapperModule();
+        if (SImageCacheEnabled)
         {
-            // FPaths::GetCleanFilename() could be used but rather not due to being more expensive.
-            // Also, imageFolderPath could be single or compound relative path, which must be unique to be texture name.
-            FString&& textureName = imagePath.RightChop(InImageFolderPath.Len());
-            if (UTexture2D* texture = LoadImageToTexture(imagePath, textureName))
-            {
-                OutImageTextureList.Add(texture);
-            }
-            else
+            IFileManager::Get().MakeDirectory(*GetImageCacheFolderPath(), true);
+        }
+
+        // Decode in batches, bounding the number of decoded images held in memory at once
+        const int32 imagesNum = imageFilePaths.Num();
+        const int32 batchSize = 2 * FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+        OutImageTextureList.Reserve(OutImageTextureList.Num() + imagesNum);
+        TArray<FRRDecodedImageData> decodedImages;
+        for (int32 batchStart = 0; batchStart < imagesNum; batchStart += batchSize)
+        {
+            const int32 batchNum = FMath::Min(batchSize, imagesNum - batchStart);
+            decodedImages.Reset();
+            decodedImages.SetNum(batchNum);
+            ParallelFor(batchNum,
+                        [&imageFilePaths, &decodedImages, batchStart](int32 Index)
+                        { DecodeImageFile(imageFilePaths[batchStart + Index], decodedImages[Index]); });
+
+            for (int32 i = 0; i < batchNum; ++i)
             {
-                // Continue the loading regardless of some being failed.
-                bResult = false;
-                UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed to load image to texture: [%s]"), *imagePath);
+                const FString& imagePath = imageFilePaths[batchStart + i];
+                // FPaths::GetCleanFilename() could be used but rather not due to being more expensive.
+                // Also, imageFolderPath could be single or compound relative path, which must be unique to be texture name.
+                FString&& textureName = imagePath.RightChop(InImageFolderPath.Len());
+                UTexture2D* texture = decodedImages[i].IsValid() ? CreateTextureFromImageData(decodedImages[i], textureName)
+                                                                 : LoadImageToTexture(imagePath, textureName);
+                if (texture)
+                {
+                    OutImageTextureList.Add(texture);
+                }
+                else
+                {
+                    // Continue the loading regardless of some being failed.
+                    bResult = false;
+                    UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed to load image to texture: [%s]"), *imagePath);
+                }
             }
         }
     }
@@ -326,13 +453,13 @@ bool URRCoreUtils::LoadImagesFromFolder(const FString& InImageFolderPath,
 }
 
 // Ref: DatasmithRuntime::GetTextureDataForIes() & CreateIESTexture()
-UTextureLightProfile* URRCoreUtils::LoadIESProfile(const FString& InFullFilePath, const FString& InLightProfileName)
+bool URRCoreUtils::ParseIESProfile(const FString& InFullFilePath, FRRLightProfileData& OutLightProfileData)
 {
     TArray<uint8> buffer;
     if (!(FFileHelper::LoadFileToArray(buffer, *InFullFilePath) && buffer.Num() > 0))
     {
         UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed loading file to array [%s]"), *InFullFilePath);
-        return nullptr;
+        return false;
     }
 
     // checks for .IES extension to avoid wasting loading large assets just to reject them during header parsing
@@ -341,22 +468,23 @@ UTextureLightProfile* URRCoreUtils::LoadIESProfile(const FString& InFullFilePath
     {
         UE_LOG_WITH_INFO(
             LogRapyutaCore, Error, TEXT("IESConverter failed creating buffer from image loaded from [%s]"), *InFullFilePath);
-        return nullptr;
+        return false;
     }
 
-    // Fille loaded data into [SLightProfileData]
-    SLightProfileData.Width = iesConverter.GetWidth();
-    SLightProfileData.Height = iesConverter.GetHeight();
-    SLightProfileData.Brightness = iesConverter.GetBrightness();
-    SLightProfileData.BytesPerPixel = 8;    // RGBA16F
-    SLightProfileData.Pitch = SLightProfileData.Width * SLightProfileData.BytesPerPixel;
-    SLightProfileData.TextureMultiplier = iesConverter.GetMultiplier();
-    const TArray<uint8>& rawData = iesConverter.GetRawData();
-    SLightProfileData.ImageData = (uint8*)FMemory::Malloc(rawData.Num() * sizeof(uint8), 0x20);
-    FMemory::Memcpy(SLightProfileData.ImageData, rawData.GetData(), rawData.Num() * sizeof(uint8));
-    ensure(SLightProfileData.ImageData);
-
-    // [SLightProfileData] -> [lightProfile]
+    OutLightProfileData.Width = iesConverter.GetWidth();
+    OutLightProfileData.Height = iesConverter.GetHeight();
+    OutLightProfileData.Brightness = iesConverter.GetBrightness();
+    OutLightProfileData.BytesPerPixel = 8;    // RGBA16F
+    OutLightProfileData.Pitch = OutLightProfileData.Width * OutLightProfileData.BytesPerPixel;
+    OutLightProfileData.TextureMultiplier = iesConverter.GetMultiplier();
+    OutLightProfileData.ImageData = iesConverter.GetRawData();
+    return true;
+}
+
+UTextureLightProfile* URRCoreUtils::CreateLightProfile(const FRRLightProfileData& InLightProfileData,
+                                                       const FString& InLightProfileName)
+{
+    check(IsInGameThread());
     UTextureLightProfile* lightProfile = NewObject<UTextureLightProfile>(GetTransientPackage(), *InLightProfileName, RF_Transient);
     if (!lightProfile)
     {
@@ -368,13 +496,12 @@ UTextureLightProfile* URRCoreUtils::LoadIESProfile(const FString& InFullFilePath
     importInfo.Insert(FAssetImportInfo::FSourceFile(InLightProfileName));
     lightProfile->AssetImportData->SourceData = MoveTemp(importInfo);
 
-    lightProfile->Source.Init(SLightProfileData.Width,
-                              SLightProfileData.Height,
+    lightProfile->Source.Init(InLightProfileData.Width,
+                              InLightProfileData.Height,
                               /*NumSlices=*/1,
                               1,
                               TSF_RGBA16F,
-                              SLightProfileData.ImageData);
-    CleanupLightProfileData(nullptr, nullptr);
+                              InLightProfileData.ImageData.GetData());
 #endif
 
     lightProfile->LODGroup = TEXTUREGROUP_IESLightProfile;
@@ -384,25 +511,61 @@ UTextureLightProfile* URRCoreUtils::LoadIESProfile(const FString& InFullFilePath
 #if WITH_EDITORONLY_DATA
     lightProfile->MipGenSettings = TMGS_NoMipmaps;
 #endif
-    lightProfile->Brightness = SLightProfileData.Brightness;
-    lightProfile->TextureMultiplier = SLightProfileData.TextureMultiplier;
+    lightProfile->Brightness = InLightProfileData.Brightness;
+    lightProfile->TextureMultiplier = InLightProfileData.TextureMultiplier;
 
     // Update the texture with these new settings
     lightProfile->UpdateResource();
 
 #if !WITH_EDITOR
-    SLightProfileData.Region = FUpdateTextureRegion2D(0, 0, 0, 0, SLightProfileData.Width, SLightProfileData.Height);
+    // The region update is async on render thread, thus owning its own copy of data, freed upon completion
+    const int32 dataSize = InLightProfileData.ImageData.Num();
+    uint8* imageData = static_cast<uint8*>(FMemory::Malloc(dataSize, 0x20));
+    FMemory::Memcpy(imageData, InLightProfileData.ImageData.GetData(), dataSize);
+    auto* region = new FUpdateTextureRegion2D(0, 0, 0, 0, InLightProfileData.Width, InLightProfileData.Height);
     lightProfile->UpdateTextureRegions(0,
                                        1,
-                                       &SLightProfileData.Region,
-                                       SLightProfileData.Pitch,
-                                       SLightProfileData.BytesPerPixel,
-                                       SLightProfileData.ImageData,
-                                       CleanupLightProfileData);
+                                       region,
+                                       InLightProfileData.Pitch,
+                                       InLightProfileData.BytesPerPixel,
+                                       imageData,
+                                       [](uint8* InSrcData, const FUpdateTextureRegion2D* InRegions)
+                                       {
+                                           FMemory::Free(InSrcData);
+                                           delete InRegions;
+                                       });
 #endif
     return lightProfile;
 }
 
+UTextureLightProfile* URRCoreUtils::LoadIESProfile(const FString& InFullFilePath, const FString& InLightProfileName)
+{
+    const FDateTime fileTimeStamp = IFileManager::Get().GetTimeStamp(*InFullFilePath);
+    FRRCachedLightProfile& cachedProfile = SLightProfileCache.FindOrAdd(InFullFilePath);
+    if (cachedProfile.Data.IsValid() && (cachedProfile.FileTimeStamp == fileTimeStamp))
+    {
+        if (UTextureLightProfile* lightProfile = cachedProfile.LightProfile.Get())
+        {
+            return lightProfile;
+        }
+    }
+    else
+    {
+        TSharedPtr<FRRLightProfileData> data = MakeShared<FRRLightProfileData>();
+        if (false == ParseIESProfile(InFullFilePath, *data))
+        {
+            SLightProfileCache.Remove(InFullFilePath);
+            return nullptr;
+        }
+        cachedProfile.FileTimeStamp = fileTimeStamp;
+        cachedProfile.Data = MoveTemp(data);
+    }
+
+    UTextureLightProfile* lightProfile = CreateLightProfile(*cachedProfile.Data, InLightProfileName);
+    cachedProfile.LightProfile = lightProfile;
+    return lightProfile;
+}
+
 bool URRCoreUtils::LoadIESProfilesFromFolder(const FString& InFolderPath,
                                              TArray<UTextureLightProfile*>& OutLightProfileList,
                                              bool bIsLogged)
@@ -411,6 +574,45 @@ bool URRCoreUtils::LoadIESProfilesFromFolder(const FString& InFolderPath,
     bool bResult = LoadFullFilePaths(InFolderPath, filePaths, {ERRFileType::LIGHT_PROFILE_IES});
     if (bResult)
     {
+        // 1- Parse new or modified IES files in parallel
+        TArray<FString> filePathsToParse;
+        TArray<FDateTime> fileTimeStamps;
+        for (const auto& iesProfilePath : filePaths)
+        {
+            const FDateTime fileTimeStamp = IFileManager::Get().GetTimeStamp(*iesProfilePath);
+            const FRRCachedLightProfile* cachedProfile = SLightProfileCache.Find(iesProfilePath);
+            if (!(cachedProfile && cachedProfile->Data.IsValid() && (cachedProfile->FileTimeStamp == fileTimeStamp)))
+            {
+                filePathsToParse.Add(iesProfilePath);
+                fileTimeStamps.Add(fileTimeStamp);
+            }
+        }
+
+        TArray<TSharedPtr<FRRLightProfileData>> parsedData;
+        parsedData.SetNum(filePathsToParse.Num());
+        ParallelFor(filePathsToParse.Num(),
+                    [&filePathsToParse, &parsedData](int32 Index)
+                    {
+                        TSharedPtr<FRRLightProfileData> data = MakeShared<FRRLightProfileData>();
+                        if (ParseIESProfile(filePathsToParse[Index], *data))
+                        {
+                            parsedData[Index] = MoveTemp(data);
+                        }
+                    });
+
+        for (int32 i = 0; i < filePathsToParse.Num(); ++i)
+        {
+            if (parsedData[i].IsValid())
+            {
+                FRRCachedLightProfile& cachedProfile = SLightProfileCache.FindOrAdd(filePathsToParse[i]);
+                cachedProfile.FileTimeStamp = fileTimeStamps[i];
+                cachedProfile.Data = MoveTemp(parsedData[i]);
+                cachedProfile.LightProfile.Reset();
+            }
+        }
+
+        // 2- Create light profiles, or reuse cached ones, on game thread
+        OutLightProfileList.Reserve(OutLightProfileList.Num() + filePaths.Num());
         for (const auto& iesProfilePath : filePaths)
         {
             // FPaths::GetCleanFilename() could be used but rather not due to being more expensive.
@@ -2,6 +2,7 @@
 #include "Core/RRCrowdROSController.h"
 
 // RapyutaSimulationPlugins
+#include "Core/RRCrowdSignificanceManager.h"
 #include "Robots/RRBaseRobot.h"
 #include "Robots/RRRobotROS2Interface.h"
 
@@ -18,7 +19,15 @@ void ARRCrowdROSController::OnPossess(APawn* InPawn)
     auto* robot = Cast<ARRBaseRobot>(InPawn);
     if (robot)
     {
-        robot->InitROS2Interface();
+        auto* significanceManager = GetWorld()->GetSubsystem<URRCrowdSignificanceManager>();
+        if (bUseSignificanceLOD && significanceManager)
+        {
+            significanceManager->RegisterAgent(robot);
+        }
+        else
+        {
+            robot->InitROS2Interface();
+        }
     }
     else
     {
@@ -31,6 +40,11 @@ void ARRCrowdROSController::OnUnPossess()
     auto* robot = GetPawn<ARRBaseRobot>();
     if (robot)
     {
+        auto* significanceManager = GetWorld()->GetSubsystem<URRCrowdSignificanceManager>();
+        if (significanceManager)
+        {
+            significanceManager->UnregisterAgent(robot);
+        }
         robot->DeInitROS2Interface();
     }
     else
@@ -0,0 +1,156 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Core/RRCrowdSignificanceManager.h"
+
+// UE
+#include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
+
+// RapyutaSimulationPlugins
+#include "Drives/RRFloatingMovementComponent.h"
+#include "Robots/RRBaseRobot.h"
+#include "Robots/RRRobotROS2Interface.h"
+
+void URRCrowdSignificanceManager::RegisterObserver(AActor* InObserver)
+{
+    if (InObserver)
+    {
+        Observers.AddUnique(InObserver);
+    }
+}
+
+void URRCrowdSignificanceManager::UnregisterObserver(AActor* InObserver)
+{
+    Observers.Remove(InObserver);
+}
+
+void URRCrowdSignificanceManager::RegisterAgent(ARRBaseRobot* InAgent)
+{
+    if ((nullptr == InAgent) || Agents.ContainsByPredicate([InAgent](const FRRCrowdAgentSignificance& InAgentSignificance)
+                                                           { return (InAgent == InAgentSignificance.Agent); }))
+    {
+        return;
+    }
+    FRRCrowdAgentSignificance& agentSignificance = Agents.AddDefaulted_GetRef();
+    agentSignificance.Agent = InAgent;
+    agentSignificance.ROS2Interface = InAgent->ROS2Interface;
+    SetAgentMovementDetail(InAgent, false);
+}
+
+void URRCrowdSignificanceManager::UnregisterAgent(ARRBaseRobot* InAgent)
+{
+    const int32 agentIndex = Agents.IndexOfByPredicate([InAgent](const FRRCrowdAgentSignificance& InAgentSignificance)
+                                                       { return (InAgent == InAgentSignificance.Agent); });
+    if (INDEX_NONE == agentIndex)
+    {
+        return;
+    }
+
+    // Restore the agent's ROS2Interface reference, for its controller to deinit it afterwards
+    if (Agents[agentIndex].bIsROS2InterfaceInitialized && (nullptr == InAgent->ROS2Interface))
+    {
+        InAgent->ROS2Interface = Agents[agentIndex].ROS2Interface;
+    }
+    SetAgentMovementDetail(InAgent, true);
+    Agents.RemoveAtSwap(agentIndex);
+}
+
+bool URRCrowdSignificanceManager::IsAgentSignificant(const ARRBaseRobot* InAgent) const
+{
+    const FRRCrowdAgentSignificance* agentSignificance = Agents.FindByPredicate(
+        [InAgent](const FRRCrowdAgentSignificance& InAgentSignificance) { return (InAgent == InAgentSignificance.Agent); });
+    return agentSignificance && agentSignificance->bIsSignificant;
+}
+
+void URRCrowdSignificanceManager::Tick(float InDeltaTime)
+{
+    TimeSinceLastUpdate += InDeltaTime;
+    if ((TimeSinceLastUpdate >= UpdateInterval) && (Agents.Num() > 0))
+    {
+        TimeSinceLastUpdate = 0.f;
+        UpdateSignificance();
+    }
+}
+
+void URRCrowdSignificanceManager::UpdateSignificance()
+{
+    Observers.RemoveAllSwap([](const TWeakObjectPtr<AActor>& InObserver) { return (false == InObserver.IsValid()); });
+    Agents.RemoveAllSwap([](const FRRCrowdAgentSignificance& InAgentSignificance)
+                         { return (false == InAgentSignificance.Agent.IsValid()); });
+
+    // Squared distance to the nearest observer, shrunk for significant agents as hysteresis
+    const float hysteresisRatioSquared = FMath::Square(FMath::Max(HysteresisRatio, 1.f));
+    TArray<TPair<float, int32>> rankedAgents;
+    rankedAgents.Reserve(Agents.Num());
+    for (int32 i = 0; i < Agents.Num(); ++i)
+    {
+        FRRCrowdAgentSignificance& agentSignificance = Agents[i];
+        const FVector agentLocation = agentSignificance.Agent->GetActorLocation();
+        agentSignificance.DistanceSquared = MAX_flt;
+        for (const auto& observer : Observers)
+        {
+            agentSignificance.DistanceSquared =
+                FMath::Min(agentSignificance.DistanceSquared, FVector::DistSquared(agentLocation, observer->GetActorLocation()));
+        }
+        rankedAgents.Emplace(agentSignificance.bIsSignificant ? agentSignificance.DistanceSquared / hysteresisRatioSquared
+                                                              : agentSignificance.DistanceSquared,
+                             i);
+    }
+    rankedAgents.Sort([](const TPair<float, int32>& InA, const TPair<float, int32>& InB) { return InA.Key < InB.Key; });
+
+    for (int32 rank = 0; rank < rankedAgents.Num(); ++rank)
+    {
+        FRRCrowdAgentSignificance& agentSignificance = Agents[rankedAgents[rank].Value];
+        const bool bIsSignificant = (rank < MaxSignificantAgentsNum);
+        if (bIsSignificant != agentSignificance.bIsSignificant)
+        {
+            SetAgentSignificant(agentSignificance, bIsSignificant);
+        }
+    }
+}
+
+void URRCrowdSignificanceManager::SetAgentSignificant(FRRCrowdAgentSignificance& InOutAgentSignificance, bool bInIsSignificant)
+{
+    ARRBaseRobot* agent = InOutAgentSignificance.Agent.Get();
+    InOutAgentSignificance.bIsSignificant = bInIsSignificant;
+    if (bInIsSignificant)
+    {
+        // ROS 2 node, publishers & subscribers are only created upon first promotion, then kept to avoid node churn
+        if (false == InOutAgentSignificance.bIsROS2InterfaceInitialized)
+        {
+            agent->InitROS2Interface();
+            InOutAgentSignificance.ROS2Interface = agent->ROS2Interface;
+            InOutAgentSignificance.bIsROS2InterfaceInitialized = true;
+        }
+        else if (InOutAgentSignificance.ROS2Interface)
+        {
+            InOutAgentSignificance.ROS2Interface->StartPublishers();
+        }
+    }
+    else if (InOutAgentSignificance.bIsROS2InterfaceInitialized && InOutAgentSignificance.ROS2Interface)
+    {
+        InOutAgentSignificance.ROS2Interface->StopPublishers();
+    }
+    SetAgentMovementDetail(agent, bInIsSignificant);
+}
+
+void URRCrowdSignificanceManager::SetAgentMovementDetail(ARRBaseRobot* InAgent, bool bInIsFullDetail)
+{
+    const float tickInterval = bInIsFullDetail ? 0.f : InsignificantTickInterval;
+    if (InAgent->MovementComponent)
+    {
+        InAgent->MovementComponent->SetComponentTickInterval(tickInterval);
+    }
+    if (auto* floatMovementComp = Cast<URRFloatingMovementComponent>(InAgent->MovementComponent))
+    {
+        // Planar navmesh movement is sweep-free by itself, while sweeps are kept enabled for its fallback to the regular
+        // movement, eg when the agent is off the navmesh
+        floatMovementComp->SetPlanarNavMeshMovement(false == bInIsFullDetail);
+    }
+
+    const auto* controller = InAgent->GetController<AAIController>();
+    if (controller && controller->GetPathFollowingComponent())
+    {
+        controller->GetPathFollowingComponent()->SetComponentTickInterval(tickInterval);
+    }
+}
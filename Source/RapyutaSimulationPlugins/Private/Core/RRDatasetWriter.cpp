@@ -0,0 +1,264 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Core/RRDatasetWriter.h"
+
+// UE
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRCoreUtils.h"
+#include "Core/RRThreadUtils.h"
+
+FRRDatasetWriter::FRRDatasetWriter(const FString& InOutputFolderPath, int32 InMaxPendingFramesNum, int32 InFramesPerShard)
+    : OutputFolderPath(InOutputFolderPath),
+      MaxPendingFramesNum(FMath::Max(InMaxPendingFramesNum, 1)),
+      FramesPerShard(FMath::Max(InFramesPerShard, 1))
+{
+    // Module loading must be on game thread, image wrappers are then created per frame by workers
+    URRCoreUtils::LoadImageWrapperModule();
+    IFileManager::Get().MakeDirectory(*OutputFolderPath, true);
+}
+
+FRRDatasetWriter::~FRRDatasetWriter()
+{
+    // NOTE: Workers hold a shared ref to this writer, thus are all done by now
+    ensure(0 == PendingFramesNum.GetValue());
+}
+
+bool FRRDatasetWriter::EnqueueFrame(FRRDatasetFrame&& InFrame)
+{
+    check(IsInGameThread());
+    if (false == CanEnqueueFrame())
+    {
+        return false;
+    }
+
+    // Check free disk space for a whole shard of such frames, periodically only since it is a system call
+    if (0 == (EnqueuedFramesNum % DISK_SPACE_CHECK_FRAMES_INTERVAL))
+    {
+        const uint64 frameSize = InFrame.ImageData.Num(InFrame.BitDepth) * GetBytesPerPixel(InFrame.BitDepth);
+        if (false == URRCoreUtils::HasEnoughDiskSpace(OutputFolderPath, frameSize * FramesPerShard))
+        {
+            bIsDiskFull = true;
+            UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Dataset writing to [%s] stopped: disk is full"), *OutputFolderPath);
+            return false;
+        }
+    }
+
+    // Entities must not be accessed outside game thread
+    for (auto& entityLogInfo : InFrame.EntityLogInfos)
+    {
+        entityLogInfo.Entities.Reset();
+    }
+
+    // Drop the tasks of already written frames
+    WriteTasks.RemoveAllSwap([](const TFuture<void>& InWriteTask) { return InWriteTask.IsReady(); });
+
+    const int32 frameIndex = EnqueuedFramesNum++;
+    PendingFramesNum.Increment();
+    WriteTasks.Add(URRThreadUtils::DoAsyncTaskInThread<void>(
+        [writer = AsShared(), frame = MoveTemp(InFrame), frameIndex]()
+        {
+            writer->WriteFrame(frame, frameIndex);
+            writer->PendingFramesNum.Decrement();
+        },
+        []() {},
+        EAsyncExecution::ThreadPool));
+    return true;
+}
+
+void FRRDatasetWriter::WaitForCompletion()
+{
+    check(IsInGameThread());
+    for (const auto& writeTask : WriteTasks)
+    {
+        writeTask.Wait();
+    }
+    WriteTasks.Reset();
+}
+
+int64 FRRDatasetWriter::GetBytesPerPixel(const int8 InBitDepth)
+{
+    switch (InBitDepth)
+    {
+        case URRActorCommon::IMAGE_BIT_DEPTH_INT8:
+            return sizeof(FColor);
+        case URRActorCommon::IMAGE_BIT_DEPTH_FLOAT16:
+            return sizeof(FFloat16Color);
+        case URRActorCommon::IMAGE_BIT_DEPTH_FLOAT32:
+            return sizeof(FLinearColor);
+        default:
+            return 0;
+    }
+}
+
+bool FRRDatasetWriter::EncodeImage(const FRRDatasetFrame& InFrame, TArray64<uint8>& OutData)
+{
+    const int64 pixelsNum = int64(InFrame.ImageSize.X) * InFrame.ImageSize.Y;
+    if ((pixelsNum <= 0) || (InFrame.ImageData.Num(InFrame.BitDepth) != pixelsNum))
+    {
+        return false;
+    }
+
+    const void* rawData = nullptr;
+    ERGBFormat rgbFormat = ERGBFormat::BGRA;
+    switch (InFrame.BitDepth)
+    {
+        case URRActorCommon::IMAGE_BIT_DEPTH_INT8:
+            rawData = InFrame.ImageData.GetImageData<URRActorCommon::IMAGE_BIT_DEPTH_INT8>().GetData();
+            break;
+        case URRActorCommon::IMAGE_BIT_DEPTH_FLOAT16:
+            rawData = InFrame.ImageData.GetImageData<URRActorCommon::IMAGE_BIT_DEPTH_FLOAT16>().GetData();
+            rgbFormat = ERGBFormat::RGBAF;
+            break;
+        case URRActorCommon::IMAGE_BIT_DEPTH_FLOAT32:
+            rawData = InFrame.ImageData.GetImageData<URRActorCommon::IMAGE_BIT_DEPTH_FLOAT32>().GetData();
+            rgbFormat = ERGBFormat::RGBAF;
+            break;
+        default:
+            return false;
+    }
+    const int64 rawSize = pixelsNum * GetBytesPerPixel(InFrame.BitDepth);
+
+    if (ERRFileType::NONE == InFrame.ImageFileType)
+    {
+        OutData.Append(static_cast<const uint8*>(rawData), rawSize);
+        return true;
+    }
+
+    EImageFormat imageFormat = EImageFormat::Invalid;
+    switch (InFrame.ImageFileType)
+    {
+        case ERRFileType::IMAGE_PNG:
+            imageFormat = EImageFormat::PNG;
+            break;
+        case ERRFileType::IMAGE_JPG:
+            imageFormat = EImageFormat::JPEG;
+            break;
+        case ERRFileType::IMAGE_GRAYSCALE_JPG:
+            imageFormat = EImageFormat::GrayscaleJPEG;
+            break;
+        case ERRFileType::IMAGE_EXR:
+            imageFormat = EImageFormat::EXR;
+            break;
+        default:
+            return false;
+    }
+
+    // A wrapper per frame, since [URRCoreUtils::SImageWrappers] are not thread-safe
+    TSharedPtr<IImageWrapper> imageWrapper = URRCoreUtils::SImageWrapperModule->CreateImageWrapper(imageFormat);
+    if (false == imageWrapper.IsValid())
+    {
+        return false;
+    }
+
+    bool bResult = false;
+    if (ERRFileType::IMAGE_GRAYSCALE_JPG == InFrame.ImageFileType)
+    {
+        // Ref :FLandscapeWeightmapFileFormat_Png::Export
+        if (URRActorCommon::IMAGE_BIT_DEPTH_INT8 != InFrame.BitDepth)
+        {
+            return false;
+        }
+        TArray64<uint8> grayBitmap;
+        grayBitmap.Reserve(pixelsNum);
+        for (const auto& color : InFrame.ImageData.GetImageData<URRActorCommon::IMAGE_BIT_DEPTH_INT8>())
+        {
+            grayBitmap.Add(color.R);
+        }
+        bResult = imageWrapper->SetRaw(grayBitmap.GetData(),
+                                       grayBitmap.Num(),
+                                       InFrame.ImageSize.X,
+                                       InFrame.ImageSize.Y,
+                                       ERGBFormat::Gray,
+                                       URRActorCommon::IMAGE_BIT_DEPTH_INT8);
+    }
+    else
+    {
+        bResult = imageWrapper->SetRaw(rawData, rawSize, InFrame.ImageSize.X, InFrame.ImageSize.Y, rgbFormat, InFrame.BitDepth);
+    }
+    if (false == bResult)
+    {
+        return false;
+    }
+
+    // Same qualities as [URRCoreUtils::GetCompressedImageData()]
+    OutData = imageWrapper->GetCompressed(
+        (ERRFileType::IMAGE_JPG == InFrame.ImageFileType) ? 100 : static_cast<int32>(EImageCompressionQuality::Default));
+    return (OutData.Num() > 0);
+}
+
+FString FRRDatasetWriter::MakeAnnotationLine(const FString& InImageFileName, const TArray<FRREntityLogInfo>& InEntityLogInfos)
+{
+    auto toJsonVectors = [](const auto& InVertices)
+    {
+        TArray<TSharedPtr<FJsonValue>> jsonVertices;
+        jsonVertices.Reserve(InVertices.Num());
+        for (const auto& vertex : InVertices)
+        {
+            jsonVertices.Add(MakeShared<FJsonValueString>(vertex.ToString()));
+        }
+        return jsonVertices;
+    };
+
+    TArray<TSharedPtr<FJsonValue>> jsonEntities;
+    jsonEntities.Reserve(InEntityLogInfos.Num());
+    for (const auto& entityLogInfo : InEntityLogInfos)
+    {
+        TSharedRef<FJsonObject> jsonEntity = MakeShared<FJsonObject>();
+        jsonEntity->SetStringField(TEXT("group_model_name"), entityLogInfo.GroupModelName);
+        jsonEntity->SetStringField(TEXT("group_name"), entityLogInfo.GroupName);
+        jsonEntity->SetStringField(TEXT("seg_mask_depth_stencil"), entityLogInfo.SegMaskDepthStencilStr);
+        jsonEntity->SetNumberField(TEXT("scene_id"), entityLogInfo.SceneId);
+        jsonEntity->SetStringField(TEXT("world_transform"), entityLogInfo.WorldTransform.ToString());
+        jsonEntity->SetArrayField(TEXT("bb_vertices_3d_world"), toJsonVectors(entityLogInfo.BBVertices3DInWorld));
+        jsonEntity->SetArrayField(TEXT("bb_vertices_3d_camera"), toJsonVectors(entityLogInfo.BBVertices3DInCamera));
+        jsonEntity->SetArrayField(TEXT("bb_vertices_2d"), toJsonVectors(entityLogInfo.BBVertices2D));
+        jsonEntities.Add(MakeShared<FJsonValueObject>(jsonEntity));
+    }
+
+    TSharedRef<FJsonObject> jsonFrame = MakeShared<FJsonObject>();
+    jsonFrame->SetStringField(TEXT("image"), InImageFileName);
+    jsonFrame->SetArrayField(TEXT("entities"), jsonEntities);
+
+    FString line;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> jsonWriter =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&line);
+    FJsonSerializer::Serialize(jsonFrame, jsonWriter);
+    return line;
+}
+
+void FRRDatasetWriter::WriteFrame(const FRRDatasetFrame& InFrame, const int32 InFrameIndex)
+{
+    const FString shardFolderPath = OutputFolderPath / FString::Printf(TEXT("shard_%05d"), InFrameIndex / FramesPerShard);
+    const FString imageFileName =
+        InFrame.ImageName + ((ERRFileType::NONE == InFrame.ImageFileType) ? TEXT(".raw")
+                                                                          : URRCoreUtils::GetSimFileExt(InFrame.ImageFileType));
+    TArray64<uint8> imageData;
+    if (false == EncodeImage(InFrame, imageData))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed encoding dataset frame [%s]"), *imageFileName);
+        return;
+    }
+
+    // [MakeDirectory()] is no-op if existing
+    IFileManager::Get().MakeDirectory(*shardFolderPath, true);
+    if (false == FFileHelper::SaveArrayToFile(imageData, *(shardFolderPath / imageFileName)))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed writing dataset image [%s]"), *(shardFolderPath / imageFileName));
+        return;
+    }
+
+    const FString annotationLine = MakeAnnotationLine(imageFileName, InFrame.EntityLogInfos) + LINE_TERMINATOR;
+    FScopeLock lock(&AnnotationFileMutex);
+    FFileHelper::SaveStringToFile(annotationLine,
+                                  *(shardFolderPath / ANNOTATION_FILE_NAME),
+                                  FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+                                  &IFileManager::Get(),
+                                  FILEWRITE_Append);
+}
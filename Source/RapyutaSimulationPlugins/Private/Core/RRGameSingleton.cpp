@@ -2,6 +2,11 @@
 
 #include "Core/RRGameSingleton.h"
 
+// UE
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+
 // RapyutaSim
 #include "Core/RRTypeUtils.h"
 
@@ -71,8 +76,25 @@ bool URRGameSingleton::InitializeResources()
         ResourceMap.Add(dataType, FRRResourceInfo(dataType));
     }
 
-    // READ ALL SIM DYNAMIC RESOURCES (UASSETS) INFO FROM DESGINATED [~CONTENT] FOLDERS
-    // & REGISTER THEM TO BE ASYNC LOADED INTO [ResourceMap]
+    // READ ALL SIM DYNAMIC RESOURCES (UASSETS) INFO FROM DESGINATED [~CONTENT] FOLDERS, OR THEIR CACHED MANIFEST
+    BuildResourcesManifest();
+
+    // [BODY SETUP] --
+    // Body setups are dynamically created in runtime only
+    GetSimResourceInfo(ERRResourceDataType::UE_BODY_SETUP).bHasBeenAllLoaded = true;
+
+    if (bOnDemandResourceLoading)
+    {
+        // Only the scenario's preloaded resources are waited for by [HaveAllResourcesBeenLoaded()]
+        for (auto& [_, resourceInfo] : ResourceMap)
+        {
+            resourceInfo.bHasBeenAllLoaded = true;
+        }
+        PreloadResources(PreloadResourceUniqueNames);
+        return true;
+    }
+
+    // REGISTER THEM TO BE ASYNC LOADED INTO [ResourceMap]
     // [STATIC MESH] --
     RequestResourcesLoading<ERRResourceDataType::UE_STATIC_MESH>();
 
@@ -94,10 +116,6 @@ bool URRGameSingleton::InitializeResources()
     // [DATATABLE] --
     RequestResourcesLoading<ERRResourceDataType::UE_DATA_TABLE>();
 
-    // [BODY SETUP] --
-    // Body setups are dynamically created in runtime only
-    GetSimResourceInfo(ERRResourceDataType::UE_BODY_SETUP).bHasBeenAllLoaded = true;
-
 #if RAPYUTA_SIM_VERBOSE
     UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("RESOURCES REGISTERED TO BE LOADED!"));
 #endif
@@ -112,6 +130,248 @@ void URRGameSingleton::FinalizeResources()
     }
 
     ResourceStore.Empty();
+    PendingResourceCallbacks.Empty();
+}
+
+FString URRGameSingleton::ComputeResourcesManifestStamp()
+{
+    FString stamp;
+    for (uint8 i = (static_cast<uint8>(ERRResourceDataType::NONE) + 1); i < static_cast<uint8>(ERRResourceDataType::UE_BODY_SETUP); ++i)
+    {
+        const ERRResourceDataType dataType = static_cast<ERRResourceDataType>(i);
+        for (const auto& assetsPath : GetDynamicAssetsPathList(dataType))
+        {
+            const FString assetsFolderPath = assetsPath / GetAssetsFolderName(dataType);
+            FString assetsFolderFilePath;
+            if (false == FPackageName::TryConvertLongPackageNameToFilename(assetsFolderPath + TEXT("/"), assetsFolderFilePath))
+            {
+                continue;
+            }
+
+            int32 filesNum = 0;
+            FDateTime latestModificationTime = FDateTime::MinValue();
+            IFileManager::Get().IterateDirectoryStatRecursively(
+                *assetsFolderFilePath,
+                [&filesNum, &latestModificationTime](const TCHAR* InPath, const FFileStatData& InStatData)
+                {
+                    ++filesNum;
+                    latestModificationTime = FMath::Max(latestModificationTime, InStatData.ModificationTime);
+                    return true;
+                });
+            stamp += FString::Printf(TEXT("%s:%d:%lld;"), *assetsFolderPath, filesNum, latestModificationTime.GetTicks());
+        }
+    }
+    return stamp;
+}
+
+int32 URRGameSingleton::BuildResourcesManifest()
+{
+    const FString manifestFilePath = GetResourcesManifestFilePath();
+    const FString stamp = ComputeResourcesManifestStamp();
+
+    // 1- CACHED MANIFEST, as lines of [Version], [Stamp], then [DataType\tUniqueName\tAssetPath]
+    TArray<FString> manifestLines;
+    if (FFileHelper::LoadFileToStringArray(manifestLines, *manifestFilePath) && (manifestLines.Num() >= 2) &&
+        manifestLines[0].Equals(RESOURCES_MANIFEST_VERSION) && manifestLines[1].Equals(stamp))
+    {
+        int32 assetsNum = 0;
+        for (int32 i = 2; i < manifestLines.Num(); ++i)
+        {
+            TArray<FString> fields;
+            if (3 != manifestLines[i].ParseIntoArray(fields, TEXT("\t")))
+            {
+                continue;
+            }
+            const int32 dataTypeValue = FCString::Atoi(*fields[0]);
+            if ((dataTypeValue <= static_cast<int32>(ERRResourceDataType::NONE)) ||
+                (dataTypeValue >= static_cast<int32>(ERRResourceDataType::UE_BODY_SETUP)))
+            {
+                continue;
+            }
+            GetSimResourceInfo(static_cast<ERRResourceDataType>(dataTypeValue)).AddResource(fields[1], fields[2], nullptr);
+            ++assetsNum;
+        }
+#if RAPYUTA_SIM_VERBOSE
+        UE_LOG_WITH_INFO(LogRapyutaCore, Display, TEXT("%d RESOURCES READ FROM MANIFEST [%s]"), assetsNum, *manifestFilePath);
+#endif
+        return assetsNum;
+    }
+
+    // 2- ASSET REGISTRY SCAN
+    const int32 assetsNum = CollateAssetsInfo<UStaticMesh>(ERRResourceDataType::UE_STATIC_MESH,
+                                                           GetAssetsFolderName(ERRResourceDataType::UE_STATIC_MESH)) +
+                            CollateAssetsInfo<USkeletalMesh>(ERRResourceDataType::UE_SKELETAL_MESH,
+                                                             GetAssetsFolderName(ERRResourceDataType::UE_SKELETAL_MESH)) +
+                            CollateAssetsInfo<USkeleton>(ERRResourceDataType::UE_SKELETON,
+                                                         GetAssetsFolderName(ERRResourceDataType::UE_SKELETON)) +
+                            CollateAssetsInfo<UPhysicsAsset>(ERRResourceDataType::UE_PHYSICS_ASSET,
+                                                             GetAssetsFolderName(ERRResourceDataType::UE_PHYSICS_ASSET)) +
+                            CollateAssetsInfo<UMaterialInterface>(ERRResourceDataType::UE_MATERIAL,
+                                                                  GetAssetsFolderName(ERRResourceDataType::UE_MATERIAL)) +
+                            CollateAssetsInfo<UTexture>(ERRResourceDataType::UE_TEXTURE,
+                                                        GetAssetsFolderName(ERRResourceDataType::UE_TEXTURE)) +
+                            CollateAssetsInfo<UDataTable>(ERRResourceDataType::UE_DATA_TABLE,
+                                                          GetAssetsFolderName(ERRResourceDataType::UE_DATA_TABLE));
+
+    manifestLines = {RESOURCES_MANIFEST_VERSION, stamp};
+    for (const auto& [dataType, resourceInfo] : ResourceMap)
+    {
+        for (const auto& [uniqueName, resource] : resourceInfo.Data)
+        {
+            manifestLines.Add(
+                FString::Printf(TEXT("%d\t%s\t%s"), static_cast<int32>(dataType), *uniqueName, *resource.GetAssetPath()));
+        }
+    }
+    if (false == FFileHelper::SaveStringArrayToFile(manifestLines, *manifestFilePath))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("Failed saving resources manifest [%s]"), *manifestFilePath);
+    }
+    return assetsNum;
+}
+
+bool URRGameSingleton::RequestResourceLoading(const ERRResourceDataType InDataType,
+                                              const FString& InUniqueName,
+                                              FOnSimResourceLoaded InOnLoaded)
+{
+    check(IsInGameThread());
+    FRRResourceInfo& resourceInfo = GetSimResourceInfo(InDataType);
+    FRRResource* resource = resourceInfo.Data.Find(InUniqueName);
+    if (nullptr == resource)
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore,
+                         Error,
+                         TEXT("[%s] [%s] NOT FOUND IN RESOURCES MANIFEST"),
+                         *URRTypeUtils::GetERRResourceDataTypeAsString(InDataType),
+                         *InUniqueName);
+        return false;
+    }
+
+    resource->RefCount++;
+    if (resource->AssetData)
+    {
+        InOnLoaded.ExecuteIfBound(resource->AssetData);
+        return true;
+    }
+
+    const FSoftObjectPath resourceSoftObjPath = resource->AssetPath;
+    if (InOnLoaded.IsBound())
+    {
+        PendingResourceCallbacks.FindOrAdd(resourceSoftObjPath).Add(MoveTemp(InOnLoaded));
+    }
+    if (resource->bIsLoading)
+    {
+        return true;
+    }
+
+    UAssetManager* assetManager = UAssetManager::GetIfValid();
+    if (nullptr == assetManager)
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("UNABLE TO GET ASSET MANAGER!"));
+        return false;
+    }
+
+    // Accounted before requesting, since the completion delegate is run right away for already loaded assets
+    resource->bIsLoading = true;
+    resourceInfo.ToBeAsyncLoadedResourceNum++;
+    resourceInfo.bHasBeenAllLoaded = false;
+
+    // https://docs.unrealengine.com/en-US/Resources/SampleGames/ARPG/BalancingBlueprintAndCPP/index.html
+    // "Avoid Referencing Assets by String"
+    TSharedPtr<FStreamableHandle> loadHandle = assetManager->GetStreamableManager().RequestAsyncLoad(
+        resourceSoftObjPath,
+        FStreamableDelegate::CreateUObject(this, &URRGameSingleton::OnResourceLoaded, InDataType, resourceSoftObjPath, InUniqueName));
+
+    // [resource] may have been invalidated by the completion delegate
+    if (FRRResource* loadedResource = resourceInfo.Data.Find(InUniqueName))
+    {
+        loadedResource->LoadHandle = loadHandle;
+    }
+    return true;
+}
+
+int32 URRGameSingleton::PreloadResources(const TArray<FString>& InUniqueNames)
+{
+    int32 foundNum = 0;
+    for (const auto& uniqueName : InUniqueNames)
+    {
+        // Unique names are not prefixed by data type, eg [M_] & [PM_] are both materials
+        bool bFound = false;
+        for (auto& [dataType, resourceInfo] : ResourceMap)
+        {
+            if (resourceInfo.Data.Contains(uniqueName))
+            {
+                bFound |= RequestResourceLoading(dataType, uniqueName);
+            }
+        }
+        if (bFound)
+        {
+            foundNum++;
+        }
+        else
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("PRELOAD RESOURCE [%s] NOT FOUND"), *uniqueName);
+        }
+    }
+    return foundNum;
+}
+
+void URRGameSingleton::ReleaseResource(const ERRResourceDataType InDataType, const FString& InUniqueName)
+{
+    check(IsInGameThread());
+    FRRResource* resource = GetSimResourceInfo(InDataType).Data.Find(InUniqueName);
+    if ((nullptr == resource) || (resource->RefCount <= 0))
+    {
+        return;
+    }
+
+    resource->RefCount--;
+    if ((resource->RefCount > 0) || (false == bOnDemandResourceLoading) || (false == bEvictUnreferencedResources) ||
+        (nullptr == resource->LoadHandle) || resource->bIsLoading)
+    {
+        return;
+    }
+
+    // Kept in the manifest to be loaded again on demand, the asset itself being reclaimed by next GC
+    ResourceStore.RemoveSingleSwap(resource->AssetData);
+    resource->AssetData = nullptr;
+    resource->LoadHandle->ReleaseHandle();
+    resource->LoadHandle.Reset();
+}
+
+UObject* URRGameSingleton::LoadResourceSynchronously(const ERRResourceDataType InDataType, const FString& InUniqueName)
+{
+    check(IsInGameThread());
+    FRRResource* resource = GetSimResourceInfo(InDataType).Data.Find(InUniqueName);
+
+    // Runtime-generated resources' place-holders have no asset path
+    if ((nullptr == resource) || resource->AssetPath.IsNull() || (ERRResourceDataType::UE_BODY_SETUP == InDataType))
+    {
+        return resource ? resource->AssetData : nullptr;
+    }
+    if (resource->AssetData)
+    {
+        return resource->AssetData;
+    }
+
+    if ((false == resource->bIsLoading) && (false == RequestResourceLoading(InDataType, InUniqueName)))
+    {
+        return nullptr;
+    }
+
+    resource = GetSimResourceInfo(InDataType).Data.Find(InUniqueName);
+    if (resource && resource->LoadHandle)
+    {
+#if RAPYUTA_SIM_VERBOSE
+        UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("[%s] NOT PRELOADED -> LOADED SYNCHRONOUSLY"), *InUniqueName);
+#endif
+        TSharedPtr<FStreamableHandle> loadHandle = resource->LoadHandle;
+        loadHandle->WaitUntilComplete();
+
+        // The completion delegate may only be run later, thus processed here right away
+        OnResourceLoaded(InDataType, resource->AssetPath, InUniqueName);
+    }
+    resource = GetSimResourceInfo(InDataType).Data.Find(InUniqueName);
+    return resource ? resource->AssetData : nullptr;
 }
 
 bool URRGameSingleton::HaveAllResourcesBeenLoaded(bool bIsLogged) const
@@ -0,0 +1,145 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Core/RRInstanceIdCaptureComponent.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRGameSingleton.h"
+#include "Core/RRMeshActor.h"
+
+URRInstanceIdCaptureComponent::URRInstanceIdCaptureComponent()
+{
+    bCaptureEveryFrame = false;
+    bCaptureOnMovement = false;
+    CaptureSource = ESceneCaptureSource::SCS_SceneColorHDR;
+    PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList;
+
+    // Ids must be output as-is, neither blended nor exposed
+    ShowFlags.SetAntiAliasing(false);
+    ShowFlags.SetTemporalAA(false);
+    ShowFlags.SetMotionBlur(false);
+    ShowFlags.SetBloom(false);
+    ShowFlags.SetEyeAdaptation(false);
+    ShowFlags.SetFog(false);
+    ShowFlags.SetAtmosphere(false);
+    PostProcessSettings.bOverride_AutoExposureMethod = true;
+    PostProcessSettings.AutoExposureMethod = EAutoExposureMethod::AEM_Manual;
+    PostProcessSettings.bOverride_AutoExposureBias = true;
+    PostProcessSettings.AutoExposureBias = 0.f;
+    PostProcessSettings.bOverride_AutoExposureApplyPhysicalCameraExposure = true;
+    PostProcessSettings.AutoExposureApplyPhysicalCameraExposure = false;
+}
+
+bool URRInstanceIdCaptureComponent::Initialize(const FIntPoint& InImageSize)
+{
+    TextureTarget = NewObject<UTextureRenderTarget2D>(this, UTextureRenderTarget2D::StaticClass());
+    TextureTarget->InitCustomFormat(InImageSize.X, InImageSize.Y, EPixelFormat::PF_A32B32G32R32F, true);
+
+    InstanceIdMaterial =
+        URRGameSingleton::Get()->GetSimResource<UMaterialInterface>(ERRResourceDataType::UE_MATERIAL, InstanceIdMaterialName, false);
+    if (nullptr == InstanceIdMaterial)
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Instance id material [%s] not found"), *InstanceIdMaterialName);
+        return false;
+    }
+    return true;
+}
+
+void URRInstanceIdCaptureComponent::CaptureInstanceIds(const TArray<ARRMeshActor*>& InEntities, const TArray<AActor*>& InOccluders)
+{
+    if ((nullptr == TextureTarget) || (nullptr == InstanceIdMaterial))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("[%s] Not yet initialized"), *GetName());
+        return;
+    }
+
+    // Swap materials of all shown mesh comps to the instance id one, which are restored right after capturing
+    TArray<TPair<UMeshComponent*, TArray<UMaterialInterface*>>> overrideMaterialsList;
+    auto swapMaterials = [this, &overrideMaterialsList](AActor* InActor)
+    {
+        TInlineComponentArray<UMeshComponent*> meshComps(InActor);
+        for (auto* meshComp : meshComps)
+        {
+            // Null for a material slot without override, thus using the mesh's own material once restored
+            TArray<UMaterialInterface*>& overrideMaterials = overrideMaterialsList.Emplace_GetRef(meshComp).Value;
+            const int32 materialsNum = FMath::Max(meshComp->GetNumMaterials(), 1);
+            overrideMaterials.Reserve(materialsNum);
+            for (int32 i = 0; i < materialsNum; ++i)
+            {
+                overrideMaterials.Add(meshComp->OverrideMaterials.IsValidIndex(i) ? meshComp->OverrideMaterials[i] : nullptr);
+                meshComp->SetMaterial(i, InstanceIdMaterial);
+            }
+        }
+        ShowOnlyActors.Add(InActor);
+    };
+
+    ShowOnlyActors.Reset();
+    for (auto* entity : InEntities)
+    {
+        if (entity && entity->IsActivated())
+        {
+            swapMaterials(entity);
+        }
+    }
+    for (auto* occluder : InOccluders)
+    {
+        if (occluder)
+        {
+            swapMaterials(occluder);
+        }
+    }
+
+    // [CaptureScene()] sends all end-of-frame render state updates beforehand, thus renders with swapped materials
+    CaptureScene();
+
+    // Restored through [SetMaterial()], which also updates the comp's render & physics states
+    for (const auto& [meshComp, overrideMaterials] : overrideMaterialsList)
+    {
+        for (int32 i = 0; i < overrideMaterials.Num(); ++i)
+        {
+            meshComp->SetMaterial(i, overrideMaterials[i]);
+        }
+    }
+    ShowOnlyActors.Reset();
+}
+
+bool URRInstanceIdCaptureComponent::ReadInstanceIdImage(FRRColorArray& OutImageData)
+{
+    FTextureRenderTargetResource* renderTargetResource = TextureTarget ? TextureTarget->GameThread_GetRenderTargetResource() : nullptr;
+    if (nullptr == renderTargetResource)
+    {
+        return false;
+    }
+    return renderTargetResource->ReadLinearColorPixels(OutImageData.ImageData<URRActorCommon::IMAGE_BIT_DEPTH_FLOAT32>(),
+                                                       FReadSurfaceDataFlags(RCM_MinMax));
+}
+
+void URRInstanceIdCaptureComponent::DecodeInstanceIdImage(const FRRColorArray& InImageData,
+                                                          const URRActorCommon* InActorCommon,
+                                                          TArray<uint32>& OutInstanceIds,
+                                                          TMap<uint32, ARRMeshActor*>& OutVisibleEntities)
+{
+    const auto& pixels = InImageData.GetImageData<URRActorCommon::IMAGE_BIT_DEPTH_FLOAT32>();
+    OutInstanceIds.SetNumUninitialized(pixels.Num());
+    OutVisibleEntities.Reset();
+    for (int32 i = 0; i < pixels.Num(); ++i)
+    {
+        uint32 instanceId = URRActorCommon::DecodeInstanceId(pixels[i]);
+        if (URRActorCommon::INSTANCE_ID_VOID != instanceId)
+        {
+            ARRMeshActor** entity = OutVisibleEntities.Find(instanceId);
+            if (nullptr == entity)
+            {
+                ARRMeshActor* foundEntity = InActorCommon ? InActorCommon->GetEntityByInstanceId(instanceId) : nullptr;
+                if (foundEntity)
+                {
+                    OutVisibleEntities.Add(instanceId, foundEntity);
+                }
+                else
+                {
+                    instanceId = URRActorCommon::INSTANCE_ID_VOID;
+                }
+            }
+        }
+        OutInstanceIds[i] = instanceId;
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Core/RRJobGraph.h"
+
+TMap<FName, FRRJobGraph::FRRJobCategory> FRRJobGraph::SCategories;
+FCriticalSection FRRJobGraph::SCategoriesMutex;
+
+void FRRJobGraph::SetCategoryConcurrencyLimit(const FName& InCategory, int32 InConcurrencyLimit)
+{
+    if (InCategory.IsNone())
+    {
+        return;
+    }
+
+    // Pending requests which fit into the new limit are granted right away, outside of the lock
+    TArray<UE::Tasks::FTaskEvent> grantedSlotEvents;
+    {
+        FScopeLock lock(&SCategoriesMutex);
+        FRRJobCategory& category = SCategories.FindOrAdd(InCategory);
+        category.ConcurrencyLimit = FMath::Max(InConcurrencyLimit, 0);
+        while ((category.PendingSlotEvents.Num() > 0) && category.HasFreeSlot())
+        {
+            category.RunningTasksNum++;
+            grantedSlotEvents.Add(category.PendingSlotEvents[0]);
+            category.PendingSlotEvents.RemoveAt(0, 1, false);
+        }
+    }
+    for (auto& slotEvent : grantedSlotEvents)
+    {
+        slotEvent.Trigger();
+    }
+}
+
+int32 FRRJobGraph::GetCategoryConcurrencyLimit(const FName& InCategory)
+{
+    if (InCategory.IsNone())
+    {
+        return 0;
+    }
+    FScopeLock lock(&SCategoriesMutex);
+    const FRRJobCategory* category = SCategories.Find(InCategory);
+    return category ? category->ConcurrencyLimit : 0;
+}
+
+void FRRJobGraph::RequestCategorySlot(const FName& InCategory, UE::Tasks::FTaskEvent& InOutSlotEvent)
+{
+    {
+        FScopeLock lock(&SCategoriesMutex);
+        FRRJobCategory& category = SCategories.FindOrAdd(InCategory);
+        // FIFO: a free slot goes to older pending requests first
+        if ((category.PendingSlotEvents.Num() > 0) || (false == category.HasFreeSlot()))
+        {
+            category.PendingSlotEvents.Add(InOutSlotEvent);
+            return;
+        }
+        category.RunningTasksNum++;
+    }
+    InOutSlotEvent.Trigger();
+}
+
+void FRRJobGraph::ReleaseCategorySlot(const FName& InCategory)
+{
+    TOptional<UE::Tasks::FTaskEvent> nextSlotEvent;
+    {
+        FScopeLock lock(&SCategoriesMutex);
+        FRRJobCategory* category = SCategories.Find(InCategory);
+        if (nullptr == category)
+        {
+            return;
+        }
+
+        // Hand the slot over as is, unless the limit has been lowered meanwhile
+        category->RunningTasksNum = FMath::Max(category->RunningTasksNum - 1, 0);
+        if ((category->PendingSlotEvents.Num() > 0) && category->HasFreeSlot())
+        {
+            category->RunningTasksNum++;
+            nextSlotEvent.Emplace(category->PendingSlotEvents[0]);
+            category->PendingSlotEvents.RemoveAt(0, 1, false);
+        }
+    }
+    if (nextSlotEvent.IsSet())
+    {
+        nextSlotEvent->Trigger();
+    }
+}
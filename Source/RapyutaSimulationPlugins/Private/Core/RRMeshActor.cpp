@@ -140,6 +140,35 @@ void ARRMeshActor::SetCustomDepthStencilValue(int32 InCustomDepthStencilValue)
     }
 }
 
+void ARRMeshActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (ActorCommon)
+    {
+        ActorCommon->UnregisterInstanceIdEntity(InstanceId, this);
+    }
+    InstanceId = URRActorCommon::INSTANCE_ID_VOID;
+    Super::EndPlay(EndPlayReason);
+}
+
+void ARRMeshActor::InitInstanceId()
+{
+    if ((URRActorCommon::INSTANCE_ID_VOID == InstanceId) && IsDataSynthEntity() && ActorCommon)
+    {
+        SetInstanceId(ActorCommon->RegisterInstanceIdEntity(this));
+    }
+}
+
+void ARRMeshActor::SetInstanceId(uint32 InInstanceId)
+{
+    InstanceId = InInstanceId;
+    const FLinearColor encodedId = URRActorCommon::EncodeInstanceId(InInstanceId);
+    for (auto& meshComp : MeshCompList)
+    {
+        meshComp->SetCustomPrimitiveDataVector3(URRActorCommon::INSTANCE_ID_CUSTOM_PRIMITIVE_DATA_INDEX,
+                                                FVector(encodedId.R, encodedId.G, encodedId.B));
+    }
+}
+
 bool ARRMeshActor::IsCustomDepthEnabled() const
 {
     for (const auto& meshComp : MeshCompList)
@@ -33,6 +33,7 @@ void ARRNetworkPlayerController::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
     UpdateLocalClock(DeltaSeconds);
+    FlushRobotVelCommands();
 }
 
 void ARRNetworkPlayerController::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -231,3 +232,72 @@ void ARRNetworkPlayerController::ServerSetAngularVel_Implementation(ARRBaseRobot
         robot->TargetAngularVel = InAngularVel;
     }
 }
+
+void ARRNetworkPlayerController::QueueRobotVelCommand(ARRBaseRobot* InServerRobot,
+                                                      float InClientTimeStamp,
+                                                      const FTransform& InClientRobotTransform,
+                                                      const FVector& InLinearVel,
+                                                      const FVector& InAngularVel)
+{
+    if (nullptr == InServerRobot)
+    {
+        return;
+    }
+
+    FRRRobotVelCommand& command = PendingRobotVelCommands.FindOrAdd(InServerRobot);
+    command.ClientTimeStamp = InClientTimeStamp;
+    command.ClientRobotTransform = InClientRobotTransform;
+    command.LinearVel = InLinearVel;
+    command.AngularVel = InAngularVel;
+    command.PendingSendsNum = 1 + FMath::Max(RobotVelCommandResendsNum, 0);
+}
+
+void ARRNetworkPlayerController::FlushRobotVelCommands()
+{
+    for (auto it = PendingRobotVelCommands.CreateIterator(); it; ++it)
+    {
+        FRRRobotVelCommand& command = it.Value();
+        if (IsValid(it.Key()))
+        {
+            ServerSetRobotVels(it.Key(),
+                               command.ClientTimeStamp,
+                               command.ClientRobotTransform.GetTranslation(),
+                               command.ClientRobotTransform.Rotator(),
+                               command.LinearVel,
+                               command.AngularVel);
+        }
+        if ((--command.PendingSendsNum <= 0) || (false == IsValid(it.Key())))
+        {
+            it.RemoveCurrent();
+        }
+    }
+}
+
+void ARRNetworkPlayerController::ServerSetRobotVels_Implementation(ARRBaseRobot* InServerRobot,
+                                                                   float InClientTimeStamp,
+                                                                   const FVector_NetQuantize100& InClientRobotLocation,
+                                                                   const FRotator& InClientRobotRotation,
+                                                                   const FVector_NetQuantize100& InLinearVel,
+                                                                   const FVector_NetQuantize100& InAngularVel)
+{
+    if (false == IsValid(InServerRobot))
+    {
+        return;
+    }
+
+    // Drop out-of-order commands, while re-sent ones with the same time stamp are still applied
+    float& lastTimeStamp = LastRobotVelCommandTimeStamps.FindOrAdd(InServerRobot, InClientTimeStamp);
+    if (InClientTimeStamp < lastTimeStamp)
+    {
+        return;
+    }
+    lastTimeStamp = InClientTimeStamp;
+
+    const float elapsedTime = UGameplayStatics::GetRealTimeSeconds(GetWorld()) - InClientTimeStamp;
+    InServerRobot->SetActorLocationAndRotation(
+        InClientRobotLocation + InClientRobotRotation.Quaternion() * InLinearVel * elapsedTime,
+        InClientRobotRotation + FRotator::MakeFromEuler(InAngularVel) * elapsedTime);
+    //NOTE: Don't use ARRBaseRobot::SetLinearVel/SetAngularVel() here, which are only for client
+    InServerRobot->TargetLinearVel = InLinearVel;
+    InServerRobot->TargetAngularVel = InAngularVel;
+}
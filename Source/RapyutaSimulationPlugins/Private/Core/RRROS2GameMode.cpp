@@ -11,6 +11,7 @@
 
 // RapyutaSimulationPlugins
 #include "Core/RRNetworkGameMode.h"
+#include "Sensors/RRSensorBudgetManager.h"
 #include "Tools/RRGhostPlayerPawn.h"
 #include "Tools/RRROS2ClockPublisher.h"
 
@@ -90,6 +91,13 @@ void ARRROS2GameMode::InitROS2()
     ClockPublisher =
         CastChecked<URRROS2ClockPublisher>(MainROS2Node->CreatePublisherWithClass(URRROS2ClockPublisher::StaticClass()));
 
+    // Sensor budget diagnostics
+    URRSensorBudgetManager* sensorBudgetManager = GetWorld()->GetSubsystem<URRSensorBudgetManager>();
+    if (sensorBudgetManager)
+    {
+        sensorBudgetManager->InitDiagnosticsPublisher(MainROS2Node);
+    }
+
     // Signal [OnROS2Initialized]
     OnROS2Initialized.Broadcast();
 }
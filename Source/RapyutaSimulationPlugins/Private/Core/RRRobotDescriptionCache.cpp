@@ -0,0 +1,259 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Core/RRRobotDescriptionCache.h"
+
+// UE
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRCoreUtils.h"
+#include "Core/RRSDFParser.h"
+#include "Core/RRURDFParser.h"
+
+bool FRRRobotDescriptionCache::SDiskCacheEnabled = true;
+TMap<FString, FRRRobotModelInfoConstPtr> FRRRobotDescriptionCache::SModelInfoCache;
+FCriticalSection FRRRobotDescriptionCache::SModelInfoCacheMutex;
+FCriticalSection FRRRobotDescriptionCache::SSDFParserMutex;
+
+static bool IsSDFFile(const FString& InFilePath)
+{
+    return InFilePath.EndsWith(URRCoreUtils::GetSimFileExt(ERRFileType::SDF), ESearchCase::IgnoreCase);
+}
+
+static bool IsURDFFile(const FString& InFilePath)
+{
+    return InFilePath.EndsWith(URRCoreUtils::GetSimFileExt(ERRFileType::URDF), ESearchCase::IgnoreCase);
+}
+
+// Hash a description file's content, then recursively its SDF <include> model files', resolved the same way as
+// [FRRSDFParser::LoadModelInfoFromFile()]'s find callback, ie relative to the root description folder
+static bool HashDescriptionFile(const FString& InFilePath,
+                                const FString& InRootFolderPath,
+                                FSHA1& InOutSHA,
+                                TSet<FString>& InOutVisitedPaths)
+{
+    bool bIsAlreadyVisited = false;
+    InOutVisitedPaths.Add(InFilePath, &bIsAlreadyVisited);
+    if (bIsAlreadyVisited)
+    {
+        return true;
+    }
+
+    TArray<uint8> fileData;
+    if (false == FFileHelper::LoadFileToArray(fileData, *InFilePath, FILEREAD_Silent))
+    {
+        return false;
+    }
+    InOutSHA.Update(fileData.GetData(), fileData.Num());
+    if (false == IsSDFFile(InFilePath))
+    {
+        return true;
+    }
+
+    FString content;
+    FFileHelper::BufferToString(content, fileData.GetData(), fileData.Num());
+    static const FString URI_BEGIN(TEXT("<uri>"));
+    static const FString URI_END(TEXT("</uri>"));
+    int32 searchIndex = 0;
+    while (true)
+    {
+        const int32 uriBegin = content.Find(URI_BEGIN, ESearchCase::IgnoreCase, ESearchDir::FromStart, searchIndex);
+        if (INDEX_NONE == uriBegin)
+        {
+            break;
+        }
+        const int32 uriEnd = content.Find(URI_END, ESearchCase::IgnoreCase, ESearchDir::FromStart, uriBegin);
+        if (INDEX_NONE == uriEnd)
+        {
+            break;
+        }
+        searchIndex = uriEnd + URI_END.Len();
+
+        const FString uri = content.Mid(uriBegin + URI_BEGIN.Len(), uriEnd - uriBegin - URI_BEGIN.Len()).TrimStartAndEnd();
+        if (uri.StartsWith(TEXT("model://")))
+        {
+            // Mesh uris also start with [model://] but have no such .sdf file
+            const FString includedFilePath = FRRRobotDescriptionParser::GetRealPathFromMeshName(uri, InRootFolderPath) +
+                                             URRCoreUtils::GetSimFileExt(ERRFileType::SDF);
+            if (FPaths::FileExists(includedFilePath) &&
+                (false == HashDescriptionFile(includedFilePath, InRootFolderPath, InOutSHA, InOutVisitedPaths)))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FRRRobotDescriptionCache::ComputeDescriptionHash(const FString& InDescriptionFilePath, FString& OutHash)
+{
+    FSHA1 sha;
+    const FString filePath = FPaths::ConvertRelativePathToFull(InDescriptionFilePath);
+    const FTCHARToUTF8 filePathUTF8(*filePath);
+    sha.Update(reinterpret_cast<const uint8*>(filePathUTF8.Get()), filePathUTF8.Length());
+
+    TSet<FString> visitedPaths;
+    if (false == HashDescriptionFile(filePath, FPaths::GetPath(filePath), sha, visitedPaths))
+    {
+        return false;
+    }
+    sha.Final();
+    FSHAHash hash;
+    sha.GetHash(hash.Hash);
+    OutHash = hash.ToString();
+    return true;
+}
+
+void FRRRobotDescriptionCache::SerializeModelData(FArchive& InOutArchive, FRRRobotModelData& InOutModelData)
+{
+    FRRRobotModelData::StaticStruct()->SerializeBin(InOutArchive, &InOutModelData);
+
+    // [ChildModelsData] is not a UPROPERTY, due to struct recursion
+    int32 childModelsNum = InOutModelData.ChildModelsData.Num();
+    InOutArchive << childModelsNum;
+    if (InOutArchive.IsLoading())
+    {
+        if (childModelsNum < 0)
+        {
+            InOutArchive.SetError();
+            return;
+        }
+        InOutModelData.ChildModelsData.SetNum(childModelsNum);
+    }
+    for (auto& childModelData : InOutModelData.ChildModelsData)
+    {
+        SerializeModelData(InOutArchive, childModelData);
+    }
+}
+
+bool FRRRobotDescriptionCache::SaveModelDataToFile(const FRRRobotModelData& InModelData, const FString& InFilePath)
+{
+    TArray<uint8> fileData;
+    FMemoryWriter memWriter(fileData);
+    FObjectAndNameAsStringProxyArchive writer(memWriter, false);
+    uint32 magic = MODEL_DATA_FILE_MAGIC;
+    int32 version = MODEL_DATA_FILE_VERSION;
+    writer << magic;
+    writer << version;
+    SerializeModelData(writer, const_cast<FRRRobotModelData&>(InModelData));
+
+    // Via a temp file so that concurrent loaders never read a partial one
+    const FString tempFilePath = FString::Printf(TEXT("%s.%s.tmp"), *InFilePath, *FGuid::NewGuid().ToString());
+    if (FFileHelper::SaveArrayToFile(fileData, *tempFilePath) &&
+        IFileManager::Get().Move(*InFilePath, *tempFilePath, true, true, false, true))
+    {
+        return true;
+    }
+    IFileManager::Get().Delete(*tempFilePath, false, false, true);
+    return false;
+}
+
+bool FRRRobotDescriptionCache::LoadModelDataFromFile(const FString& InFilePath, FRRRobotModelData& OutModelData)
+{
+    TArray<uint8> fileData;
+    if (false == FFileHelper::LoadFileToArray(fileData, *InFilePath, FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader memReader(fileData);
+    FObjectAndNameAsStringProxyArchive reader(memReader, true);
+    uint32 magic = 0;
+    int32 version = 0;
+    reader << magic;
+    reader << version;
+    if ((MODEL_DATA_FILE_MAGIC != magic) || (MODEL_DATA_FILE_VERSION != version))
+    {
+        return false;
+    }
+    SerializeModelData(reader, OutModelData);
+    return (false == reader.IsError()) && memReader.AtEnd();
+}
+
+FRRRobotModelInfoConstPtr FRRRobotDescriptionCache::ParseModelInfoFromFile(const FString& InDescriptionFilePath)
+{
+    TSharedPtr<FRRRobotModelInfo, ESPMode::ThreadSafe> modelInfo;
+    if (IsURDFFile(InDescriptionFilePath))
+    {
+        // A parser per call since it holds parsing states
+        FRRURDFParser parser;
+        modelInfo = MakeShared<FRRRobotModelInfo, ESPMode::ThreadSafe>(parser.LoadModelInfoFromFile(InDescriptionFilePath).Data);
+    }
+    else if (IsSDFFile(InDescriptionFilePath))
+    {
+        FScopeLock lock(&SSDFParserMutex);
+        FRRSDFParser parser;
+        modelInfo = MakeShared<FRRRobotModelInfo, ESPMode::ThreadSafe>(parser.LoadModelInfoFromFile(InDescriptionFilePath).Data);
+    }
+    else
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("[%s] is neither URDF nor SDF"), *InDescriptionFilePath);
+        return nullptr;
+    }
+    return (modelInfo->Data.ModelNameList.Num() > 0) ? modelInfo : nullptr;
+}
+
+FRRRobotModelInfoConstPtr FRRRobotDescriptionCache::LoadModelInfoFromFile(const FString& InDescriptionFilePath)
+{
+    const FString filePath = FPaths::ConvertRelativePathToFull(InDescriptionFilePath);
+    FString hash;
+    if (false == ComputeDescriptionHash(filePath, hash))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed reading robot description file [%s]"), *filePath);
+        return nullptr;
+    }
+
+    // 1- Memory cache
+    {
+        FScopeLock lock(&SModelInfoCacheMutex);
+        if (const FRRRobotModelInfoConstPtr* cachedModelInfo = SModelInfoCache.Find(hash))
+        {
+            return *cachedModelInfo;
+        }
+    }
+
+    // 2- Disk cache
+    FRRRobotModelInfoConstPtr modelInfo;
+    const FString cacheFilePath = GetCacheFolderPath() / hash;
+    if (SDiskCacheEnabled)
+    {
+        TSharedPtr<FRRRobotModelInfo, ESPMode::ThreadSafe> loadedModelInfo = MakeShared<FRRRobotModelInfo, ESPMode::ThreadSafe>();
+        if (LoadModelDataFromFile(cacheFilePath, loadedModelInfo->Data))
+        {
+            modelInfo = loadedModelInfo;
+        }
+    }
+
+    // 3- Parse
+    if (nullptr == modelInfo)
+    {
+        modelInfo = ParseModelInfoFromFile(filePath);
+        if (nullptr == modelInfo)
+        {
+            return nullptr;
+        }
+        if (SDiskCacheEnabled)
+        {
+            IFileManager::Get().MakeDirectory(*GetCacheFolderPath(), true);
+            if (false == SaveModelDataToFile(modelInfo->Data, cacheFilePath))
+            {
+                UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("Failed caching robot model of [%s]"), *filePath);
+            }
+        }
+    }
+
+    // Concurrent loaders of the same description may have got here first, whose model info is then shared
+    FScopeLock lock(&SModelInfoCacheMutex);
+    return SModelInfoCache.FindOrAdd(hash, modelInfo);
+}
+
+void FRRRobotDescriptionCache::ClearCache()
+{
+    FScopeLock lock(&SModelInfoCacheMutex);
+    SModelInfoCache.Empty();
+}
@@ -0,0 +1,175 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Core/RRRobotModelsLoader.h"
+
+// UE
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRGameSingleton.h"
+#include "Core/RRMeshUtils.h"
+#include "Core/RRThreadUtils.h"
+#include "Core/RRUObjectUtils.h"
+
+TSharedRef<FRRRobotModelsLoader, ESPMode::ThreadSafe> FRRRobotModelsLoader::LoadAsync(const TArray<FString>& InDescriptionFilePaths,
+                                                                                      const FString& InRobotModelsFolderPath,
+                                                                                      FOnRobotModelsLoaded InOnLoaded,
+                                                                                      FOnRobotModelsLoadProgress InOnProgress)
+{
+    check(IsInGameThread());
+    TSharedRef<FRRRobotModelsLoader, ESPMode::ThreadSafe> loader(
+        new FRRRobotModelsLoader(InDescriptionFilePaths, InRobotModelsFolderPath));
+    loader->OnLoaded = MoveTemp(InOnLoaded);
+    loader->OnProgress = MoveTemp(InOnProgress);
+    loader->TotalItemsNum.Set(InDescriptionFilePaths.Num());
+
+    URRThreadUtils::DoAsyncTaskInThread<void>([loader]() { loader->ParseDescriptions(); },
+                                              [loader]()
+                                              { AsyncTask(ENamedThreads::GameThread, [loader]() { loader->StartMeshImports(); }); });
+    return loader;
+}
+
+void FRRRobotModelsLoader::CollectMeshFilePaths(const FRRRobotModelData& InModelData,
+                                                const FString& InRobotModelsFolderPath,
+                                                TSet<FString>& OutMeshFilePaths)
+{
+    auto addMeshFilePaths = [&InRobotModelsFolderPath, &OutMeshFilePaths](const TArray<FRRRobotGeometryInfo>& InGeometryInfoList)
+    {
+        for (const auto& geometryInfo : InGeometryInfoList)
+        {
+            // Primitive shapes are not loaded from files
+            if (ERRShapeType::MESH == URRGameSingleton::GetShapeTypeFromMeshName(geometryInfo.MeshName))
+            {
+                OutMeshFilePaths.Add(
+                    FRRRobotDescriptionParser::GetRealPathFromMeshName(geometryInfo.MeshName, InRobotModelsFolderPath));
+            }
+        }
+    };
+
+    for (const auto& linkProp : InModelData.LinkPropList)
+    {
+        addMeshFilePaths(linkProp.VisualList);
+        addMeshFilePaths(linkProp.CollisionList);
+    }
+    for (const auto& childModelData : InModelData.ChildModelsData)
+    {
+        CollectMeshFilePaths(childModelData, InRobotModelsFolderPath, OutMeshFilePaths);
+    }
+}
+
+void FRRRobotModelsLoader::ParseDescriptions()
+{
+    ModelInfos.SetNum(DescriptionFilePaths.Num());
+    ParallelFor(DescriptionFilePaths.Num(),
+                [this](int32 InIndex)
+                {
+                    ModelInfos[InIndex] = FRRRobotDescriptionCache::LoadModelInfoFromFile(DescriptionFilePaths[InIndex]);
+                    LoadedItemsNum.Increment();
+                    ReportProgress();
+                });
+}
+
+void FRRRobotModelsLoader::StartMeshImports()
+{
+    check(IsInGameThread());
+
+    // Mesh files referenced by multiple models are imported once
+    TSet<FString> meshFilePaths;
+    for (int32 i = 0; i < ModelInfos.Num(); ++i)
+    {
+        if (ModelInfos[i])
+        {
+            CollectMeshFilePaths(ModelInfos[i]->Data,
+                                 RobotModelsFolderPath.IsEmpty() ? FPaths::GetPath(DescriptionFilePaths[i]) : RobotModelsFolderPath,
+                                 meshFilePaths);
+        }
+        else
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed loading robot description [%s]"), *DescriptionFilePaths[i]);
+        }
+    }
+
+    // Skip meshes already loaded or being loaded, same as [URRStaticMeshComponent::InitializeMesh()]
+    URRGameSingleton* gameSingleton = URRGameSingleton::Get();
+    TArray<FString> meshFilePathsToImport;
+    TSet<FString> meshUniqueNames;
+    for (const auto& meshFilePath : meshFilePaths)
+    {
+        const FString meshUniqueName = URRUObjectUtils::ComposeDynamicResourceName(
+            URRGameSingleton::GetAssetNamePrefix(ERRResourceDataType::UE_STATIC_MESH), *FPaths::GetBaseFilename(meshFilePath));
+        bool bIsAlreadyAdded = false;
+        meshUniqueNames.Add(meshUniqueName, &bIsAlreadyAdded);
+        if (bIsAlreadyAdded || FRRMeshData::IsMeshDataAvailable(meshUniqueName) ||
+            gameSingleton->GetStaticMesh(meshFilePath, false) ||
+            gameSingleton->HasSimResource(ERRResourceDataType::UE_STATIC_MESH, meshUniqueName))
+        {
+            continue;
+        }
+        meshFilePathsToImport.Add(meshFilePath);
+    }
+
+    if (0 == meshFilePathsToImport.Num())
+    {
+        Complete();
+        return;
+    }
+    TotalItemsNum.Add(meshFilePathsToImport.Num());
+    URRThreadUtils::DoAsyncTaskInThread<void>(
+        [loader = AsShared(), meshFilePathsToImport]() { loader->ImportMeshes(meshFilePathsToImport); },
+        [loader = AsShared()]() { AsyncTask(ENamedThreads::GameThread, [loader]() { loader->Complete(); }); });
+}
+
+void FRRRobotModelsLoader::ImportMeshes(const TArray<FString>& InMeshFilePaths)
+{
+    MeshDataList.SetNum(InMeshFilePaths.Num());
+    ParallelFor(InMeshFilePaths.Num(),
+                [this, &InMeshFilePaths](int32 InIndex)
+                {
+                    const FString& meshFilePath = InMeshFilePaths[InIndex];
+                    TSharedPtr<Assimp::Importer> meshImporter = MakeShared<Assimp::Importer>();
+                    TSharedPtr<FRRMeshData> meshData =
+                        MakeShared<FRRMeshData>(URRMeshUtils::LoadMeshFromFile(meshFilePath, *meshImporter));
+                    meshData->MeshImporter = meshImporter;
+                    meshData->MeshUniqueName = URRUObjectUtils::ComposeDynamicResourceName(
+                        URRGameSingleton::GetAssetNamePrefix(ERRResourceDataType::UE_STATIC_MESH),
+                        *FPaths::GetBaseFilename(meshFilePath));
+                    if (meshData->IsValid())
+                    {
+                        MeshDataList[InIndex] = meshData;
+                    }
+                    else
+                    {
+                        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed importing mesh [%s]"), *meshFilePath);
+                    }
+                    LoadedItemsNum.Increment();
+                    ReportProgress();
+                });
+}
+
+void FRRRobotModelsLoader::Complete()
+{
+    check(IsInGameThread());
+    for (auto& meshData : MeshDataList)
+    {
+        // Some component may have started loading the same mesh by itself meanwhile
+        if (meshData && (false == FRRMeshData::IsMeshDataAvailable(meshData->MeshUniqueName)))
+        {
+            FRRMeshData::AddMeshData(meshData->MeshUniqueName, meshData);
+        }
+    }
+    MeshDataList.Empty();
+
+    bIsCompleted = true;
+    OnLoaded.ExecuteIfBound(ModelInfos);
+}
+
+void FRRRobotModelsLoader::ReportProgress()
+{
+    if (OnProgress.IsBound())
+    {
+        AsyncTask(ENamedThreads::GameThread,
+                  [loader = AsShared()]()
+                  { loader->OnProgress.ExecuteIfBound(loader->LoadedItemsNum.GetValue(), loader->TotalItemsNum.GetValue()); });
+    }
+}
@@ -103,8 +103,13 @@ bool ARRSceneDirector::HasOperationCompleted(bool bIsLogged)
         {
             UE_LOG_WITH_SCENE_ID(LogRapyutaCore, Display, TEXT("is still operating!"));
         }
+        else if (DatasetWriter.IsValid() && (DatasetWriter->GetPendingFramesNum() > 0))
+        {
+            UE_LOG_WITH_SCENE_ID(
+                LogRapyutaCore, Display, TEXT("is still writing [%d] data frames!"), DatasetWriter->GetPendingFramesNum());
+        }
     }
-    return !(bIsDataCollecting || bIsOperating);
+    return !(bIsDataCollecting || bIsOperating || (DatasetWriter.IsValid() && (DatasetWriter->GetPendingFramesNum() > 0)));
 }
 
 void ARRSceneDirector::OnDataCollectionPhaseDone(bool bIsFinalDataCollectingPhase)
@@ -1,2 +1,21 @@
 // Copyright 2020-2021 Rapyuta Robotics Co., Ltd.
 #include "Core/RRThreadUtils.h"
+
+void URRThreadUtils::CancelTaskInGameThreadLater(FRRDelayedTaskHandle& InOutHandle)
+{
+    if (InOutHandle.TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(InOutHandle.TickerHandle);
+        InOutHandle.TickerHandle.Reset();
+    }
+    if (InOutHandle.TimerHandle.IsValid())
+    {
+        check(IsInGameThread());
+        if (UWorld* world = InOutHandle.World.Get())
+        {
+            world->GetTimerManager().ClearTimer(InOutHandle.TimerHandle);
+        }
+        InOutHandle.TimerHandle.Invalidate();
+    }
+    InOutHandle.World = nullptr;
+}
@@ -1,6 +1,7 @@
 #include "Core/RRUObjectUtils.h"
 
 // UE
+#include "Async/ParallelFor.h"
 #include "Components/ActorComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMeshActor.h"
@@ -298,6 +299,173 @@ void URRUObjectUtils::GetActorCenterAndBoundingBoxVertices(const AActor* InActor
     }
 }
 
+int32 URRUObjectUtils::AddActorBoundingBoxHull(const AActor* InActor, FRREntityHulls& OutHulls, bool bInIncludeNonColliding)
+{
+    const FBox actorLocalBox = InActor->CalculateComponentsBoundingBoxInLocalSpace(bInIncludeNonColliding);
+    TArray<FVector3f> localHullPoints;
+    localHullPoints.Reserve(8);
+    for (int32 i = 0; i < 8; ++i)
+    {
+        localHullPoints.Emplace(FVector3f((i & 1) ? actorLocalBox.Max.X : actorLocalBox.Min.X,
+                                          (i & 2) ? actorLocalBox.Max.Y : actorLocalBox.Min.Y,
+                                          (i & 4) ? actorLocalBox.Max.Z : actorLocalBox.Min.Z));
+    }
+    return OutHulls.AddEntity(localHullPoints, InActor->GetActorTransform());
+}
+
+void URRUObjectUtils::ProjectEntityHulls(const FMatrix& InViewProjectionMatrix,
+                                         const FIntPoint& InImageSize,
+                                         const FRREntityHulls& InHulls,
+                                         FRRProjectedBoundingBoxes& OutBoxes)
+{
+    const int32 entitiesNum = InHulls.GetEntitiesNum();
+    check(InHulls.HullPointOffsets.Num() == entitiesNum + 1);
+    OutBoxes.SetNum(entitiesNum);
+
+    const FVector2f imageSize(InImageSize);
+    ParallelFor(entitiesNum,
+                [&InViewProjectionMatrix, &InHulls, &OutBoxes, &imageSize](int32 InEntityIndex)
+                {
+                    // Entity local -> clip, composed once for all of its hull points
+                    const FMatrix44f localToClip(InHulls.EntityTransforms[InEntityIndex].ToMatrixWithScale() *
+                                                 InViewProjectionMatrix);
+                    const int32 pointsBegin = InHulls.HullPointOffsets[InEntityIndex];
+                    const int32 pointsEnd = InHulls.HullPointOffsets[InEntityIndex + 1];
+
+                    FVector2f boxMin(MAX_flt, MAX_flt);
+                    FVector2f boxMax(-MAX_flt, -MAX_flt);
+                    float minDepth = MAX_flt;
+                    auto addClipPoint = [&boxMin, &boxMax, &minDepth, &imageSize](const FVector4f& InClipPoint)
+                    {
+                        const float invW = 1.f / InClipPoint.W;
+                        const FVector2f screenPoint((0.5f + 0.5f * InClipPoint.X * invW) * imageSize.X,
+                                                    (0.5f - 0.5f * InClipPoint.Y * invW) * imageSize.Y);
+                        boxMin = FVector2f::Min(boxMin, screenPoint);
+                        boxMax = FVector2f::Max(boxMax, screenPoint);
+                        minDepth = FMath::Min(minDepth, InClipPoint.W);
+                    };
+
+                    // NOTE: With UE perspective projection, W is the view depth
+                    FVector3f localCenter = FVector3f::ZeroVector;
+                    TArray<FVector4f, TInlineAllocator<8>> pointsBehind;
+                    TArray<FVector4f, TInlineAllocator<8>> pointsInFront;
+                    for (int32 i = pointsBegin; i < pointsEnd; ++i)
+                    {
+                        const FVector3f& localPoint = InHulls.LocalHullPoints[i];
+                        localCenter += localPoint;
+                        const FVector4f clipPoint = localToClip.TransformFVector4(FVector4f(localPoint, 1.f));
+                        if (clipPoint.W <= UE_KINDA_SMALL_NUMBER)
+                        {
+                            pointsBehind.Add(clipPoint);
+                        }
+                        else
+                        {
+                            pointsInFront.Add(clipPoint);
+                            addClipPoint(clipPoint);
+                        }
+                    }
+
+                    // Clip the hull against the near plane, by adding the near plane intersections of all segments between
+                    // points in front & behind, which include the clipped hull's vertices
+                    const bool bHasPointsBehind = (pointsBehind.Num() > 0);
+                    for (const FVector4f& pointBehind : pointsBehind)
+                    {
+                        for (const FVector4f& pointInFront : pointsInFront)
+                        {
+                            // Interpolated to W == UE_KINDA_SMALL_NUMBER
+                            const float alpha = (pointInFront.W - UE_KINDA_SMALL_NUMBER) /
+                                                FMath::Max(pointInFront.W - pointBehind.W, UE_SMALL_NUMBER);
+                            addClipPoint(pointInFront + (pointBehind - pointInFront) * alpha);
+                        }
+                    }
+
+                    const int32 pointsNum = pointsEnd - pointsBegin;
+                    if (pointsNum > 0)
+                    {
+                        localCenter /= pointsNum;
+                    }
+                    OutBoxes.WorldCenters[InEntityIndex] =
+                        InHulls.EntityTransforms[InEntityIndex].TransformPosition(FVector(localCenter));
+
+                    ERRProjectedBoxFlags flags = ERRProjectedBoxFlags::NONE;
+                    if ((boxMin.X < imageSize.X) && (boxMin.Y < imageSize.Y) && (boxMax.X > 0.f) && (boxMax.Y > 0.f))
+                    {
+                        flags |= ERRProjectedBoxFlags::VISIBLE;
+                        if (bHasPointsBehind || (boxMin.X < 0.f) || (boxMin.Y < 0.f) || (boxMax.X > imageSize.X) ||
+                            (boxMax.Y > imageSize.Y))
+                        {
+                            flags |= ERRProjectedBoxFlags::TRUNCATED;
+                        }
+                        boxMin = FVector2f::Max(boxMin, FVector2f::ZeroVector);
+                        boxMax = FVector2f::Min(boxMax, imageSize);
+                    }
+                    else
+                    {
+                        boxMin = boxMax = FVector2f::ZeroVector;
+                    }
+                    OutBoxes.BoxMins[InEntityIndex] = boxMin;
+                    OutBoxes.BoxMaxs[InEntityIndex] = boxMax;
+                    OutBoxes.MinDepths[InEntityIndex] = minDepth;
+                    OutBoxes.Flags[InEntityIndex] = flags;
+                });
+}
+
+void URRUObjectUtils::ProjectEntityLogInfos(const FMatrix& InViewProjectionMatrix,
+                                            const FIntPoint& InImageSize,
+                                            TArray<FRREntityLogInfo>& InOutEntityLogInfos,
+                                            FRREntityHulls& OutHulls,
+                                            FRRProjectedBoundingBoxes& OutBoxes)
+{
+    // Each group's world bounding box vertices as its hull, already in world space
+    OutHulls.Reset();
+    for (const auto& entityLogInfo : InOutEntityLogInfos)
+    {
+        for (const auto& vertex : entityLogInfo.BBVertices3DInWorld)
+        {
+            OutHulls.LocalHullPoints.Emplace(FVector3f(vertex));
+        }
+        OutHulls.HullPointOffsets.Add(OutHulls.LocalHullPoints.Num());
+        OutHulls.EntityTransforms.Add(FTransform::Identity);
+    }
+    ProjectEntityHulls(InViewProjectionMatrix, InImageSize, OutHulls, OutBoxes);
+
+    for (int32 i = 0; i < InOutEntityLogInfos.Num(); ++i)
+    {
+        TArray<FVector2D>& bbVertices2D = InOutEntityLogInfos[i].BBVertices2D;
+        bbVertices2D.Reset();
+        if (OutBoxes.IsVisible(i))
+        {
+            const FVector2D boxMin(OutBoxes.BoxMins[i]);
+            const FVector2D boxMax(OutBoxes.BoxMaxs[i]);
+            bbVertices2D.Append({boxMin, FVector2D(boxMax.X, boxMin.Y), boxMax, FVector2D(boxMin.X, boxMax.Y)});
+        }
+    }
+}
+
+void URRUObjectUtils::CheckEntityHullsOcclusion(const UWorld* InWorld,
+                                                const FVector& InViewLocation,
+                                                const TArray<const AActor*>& InEntities,
+                                                FRRProjectedBoundingBoxes& InOutBoxes,
+                                                ECollisionChannel InTraceChannel)
+{
+    check(InEntities.Num() == InOutBoxes.Flags.Num());
+    ParallelFor(InEntities.Num(),
+                [InWorld, &InViewLocation, &InEntities, &InOutBoxes, InTraceChannel](int32 InEntityIndex)
+                {
+                    if (false == InOutBoxes.IsVisible(InEntityIndex))
+                    {
+                        return;
+                    }
+                    const FCollisionQueryParams traceParams(TEXT("BBOcclusion_Trace"), false, InEntities[InEntityIndex]);
+                    FHitResult hit;
+                    if (InWorld->LineTraceSingleByChannel(
+                            hit, InViewLocation, InOutBoxes.WorldCenters[InEntityIndex], InTraceChannel, traceParams))
+                    {
+                        InOutBoxes.Flags[InEntityIndex] |= ERRProjectedBoxFlags::OCCLUDED;
+                    }
+                });
+}
+
 // Ref: ConstraintInstance.cpp - GetActorRefs()
 bool URRUObjectUtils::GetPhysicsActorHandles(FBodyInstance* InBody1,
                                              FBodyInstance* InBody2,
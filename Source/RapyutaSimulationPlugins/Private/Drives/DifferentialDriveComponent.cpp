@@ -7,6 +7,7 @@
 
 // RapyutaSimulationPlugins
 #include "Core/RRConversionUtils.h"
+#include "Drives/RRFleetDriveManager.h"
 
 DEFINE_LOG_CATEGORY(LogDifferentialDriveComponent);
 
@@ -29,6 +30,11 @@ void UDifferentialDriveComponent::SetWheels(UPhysicsConstraintComponent* InWheel
 
     fSetWheel(WheelLeft, InWheelLeft);
     fSetWheel(WheelRight, InWheelRight);
+
+    // New wheels' vel targets are applied upon next update
+    AppliedWheelLeftVelTarget = FVector(MAX_flt);
+    AppliedWheelRightVelTarget = FVector(MAX_flt);
+    AppliedMaxForce = MaxForce;
 }
 
 void UDifferentialDriveComponent::SetPerimeter()
@@ -46,7 +52,7 @@ void UDifferentialDriveComponent::TickComponent(float InDeltaTime,
                                                 FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(InDeltaTime, TickType, ThisTickFunction);
-    if (!ShouldSkipUpdate(InDeltaTime))
+    if (!bIsFleetOdomIntegrated && !ShouldSkipUpdate(InDeltaTime))
     {
         UpdateOdom(InDeltaTime);
     }
@@ -60,10 +66,25 @@ void UDifferentialDriveComponent::UpdateMovement(float DeltaTime)
         float velL = Velocity.X + angularVelRad * WheelSeparationHalf;
         float velR = Velocity.X - angularVelRad * WheelSeparationHalf;
 
-        WheelLeft->SetAngularVelocityTarget(FVector(-velL / WheelPerimeter, 0, 0));
-        WheelRight->SetAngularVelocityTarget(FVector(-velR / WheelPerimeter, 0, 0));
-        WheelLeft->SetAngularDriveParams(MaxForce, MaxForce, MaxForce);
-        WheelRight->SetAngularDriveParams(MaxForce, MaxForce, MaxForce);
+        // Each constraint write wakes up & updates the physics joint, thus only done upon change
+        const FVector velTargetL(-velL / WheelPerimeter, 0, 0);
+        const FVector velTargetR(-velR / WheelPerimeter, 0, 0);
+        if (velTargetL != AppliedWheelLeftVelTarget)
+        {
+            WheelLeft->SetAngularVelocityTarget(velTargetL);
+            AppliedWheelLeftVelTarget = velTargetL;
+        }
+        if (velTargetR != AppliedWheelRightVelTarget)
+        {
+            WheelRight->SetAngularVelocityTarget(velTargetR);
+            AppliedWheelRightVelTarget = velTargetR;
+        }
+        if (MaxForce != AppliedMaxForce)
+        {
+            WheelLeft->SetAngularDriveParams(MaxForce, MaxForce, MaxForce);
+            WheelRight->SetAngularDriveParams(MaxForce, MaxForce, MaxForce);
+            AppliedMaxForce = MaxForce;
+        }
     }
     else
     {
@@ -80,10 +101,7 @@ void UDifferentialDriveComponent::UpdateOdom(float DeltaTime)
 
     if (!OdomComponent->bIsOdomInitialized)
     {
-        OdomComponent->InitOdom();
-        PoseEncoderX = 0.f;
-        PoseEncoderY = 0.f;
-        PoseEncoderThetaRad = 0.f;
+        InitEncoderOdom();
     }
 
     FROSOdom odomData = OdomComponent->OdomData;
@@ -134,19 +152,6 @@ void UDifferentialDriveComponent::UpdateOdom(float DeltaTime)
     odomData.Twist.Twist.Linear.Y = 0;
     odomData.Twist.Twist.Linear.Z = 0;
 
-    odomData.Pose.Covariance[0] = 0.01;
-    odomData.Pose.Covariance[7] = 0.01;
-    odomData.Pose.Covariance[14] = 1e+12;
-    odomData.Pose.Covariance[21] = 1e+12;
-    odomData.Pose.Covariance[28] = 1e+12;
-    odomData.Pose.Covariance[35] = 0.01;
-    odomData.Twist.Covariance[0] = 0.01;
-    odomData.Twist.Covariance[7] = 0.01;
-    odomData.Twist.Covariance[14] = 1e+12;
-    odomData.Twist.Covariance[21] = 1e+12;
-    odomData.Twist.Covariance[28] = 1e+12;
-    odomData.Twist.Covariance[35] = 0.01;
-
     OdomComponent->OdomData = odomData;
 
 #if RAPYUTA_SIM_VERBOSE
@@ -175,6 +180,46 @@ void UDifferentialDriveComponent::UpdateOdom(float DeltaTime)
 #endif
 }
 
+void UDifferentialDriveComponent::SerializeDriveState(FArchive& InOutAr)
+{
+    Super::SerializeDriveState(InOutAr);
+    InOutAr << PoseEncoderX << PoseEncoderY << PoseEncoderThetaRad;
+
+    // Always serialized, so that the layout does not depend on fleet integration
+    URRFleetDriveManager* fleetDriveManager =
+        (bIsFleetOdomIntegrated && GetWorld()) ? GetWorld()->GetSubsystem<URRFleetDriveManager>() : nullptr;
+    uint64* fleetNoiseCounter = fleetDriveManager ? fleetDriveManager->FindNoiseCounter(this) : nullptr;
+    uint64 noiseCounter = fleetNoiseCounter ? *fleetNoiseCounter : 0;
+    InOutAr << noiseCounter;
+    if (InOutAr.IsLoading() && fleetNoiseCounter)
+    {
+        *fleetNoiseCounter = noiseCounter;
+    }
+}
+
+void UDifferentialDriveComponent::InitEncoderOdom()
+{
+    OdomComponent->InitOdom();
+    PoseEncoderX = 0.f;
+    PoseEncoderY = 0.f;
+    PoseEncoderThetaRad = 0.f;
+
+    // Covariance is constant, thus only set once here
+    FROSOdom& odomData = OdomComponent->OdomData;
+    odomData.Pose.Covariance[0] = 0.01;
+    odomData.Pose.Covariance[7] = 0.01;
+    odomData.Pose.Covariance[14] = 1e+12;
+    odomData.Pose.Covariance[21] = 1e+12;
+    odomData.Pose.Covariance[28] = 1e+12;
+    odomData.Pose.Covariance[35] = 0.01;
+    odomData.Twist.Covariance[0] = 0.01;
+    odomData.Twist.Covariance[7] = 0.01;
+    odomData.Twist.Covariance[14] = 1e+12;
+    odomData.Twist.Covariance[21] = 1e+12;
+    odomData.Twist.Covariance[28] = 1e+12;
+    odomData.Twist.Covariance[35] = 0.01;
+}
+
 void UDifferentialDriveComponent::Initialize()
 {
     Super::Initialize();
@@ -183,5 +228,25 @@ void UDifferentialDriveComponent::Initialize()
     {
         // Odom update is done by this class instead of OdomComponent.
         OdomComponent->bManualUpdate = true;
+
+        if (bFleetOdomIntegration && (false == bIsFleetOdomIntegrated))
+        {
+            URRFleetDriveManager* fleetDriveManager = GetWorld() ? GetWorld()->GetSubsystem<URRFleetDriveManager>() : nullptr;
+            bIsFleetOdomIntegrated = fleetDriveManager && fleetDriveManager->RegisterDrive(this);
+        }
+    }
+}
+
+void UDifferentialDriveComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (bIsFleetOdomIntegrated)
+    {
+        URRFleetDriveManager* fleetDriveManager = GetWorld() ? GetWorld()->GetSubsystem<URRFleetDriveManager>() : nullptr;
+        if (fleetDriveManager)
+        {
+            fleetDriveManager->UnregisterDrive(this);
+        }
+        bIsFleetOdomIntegrated = false;
     }
+    Super::EndPlay(EndPlayReason);
 }
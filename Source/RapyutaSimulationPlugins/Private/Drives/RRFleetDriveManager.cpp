@@ -0,0 +1,189 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Drives/RRFleetDriveManager.h"
+
+// UE
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Kismet/GameplayStatics.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRConversionUtils.h"
+#include "Drives/DifferentialDriveComponent.h"
+#include "Sensors/RRBaseOdomComponent.h"
+
+static inline uint64 SplitMix64(uint64 InValue)
+{
+    InValue += 0x9E3779B97F4A7C15ull;
+    InValue = (InValue ^ (InValue >> 30)) * 0xBF58476D1CE4E5B9ull;
+    InValue = (InValue ^ (InValue >> 27)) * 0x94D049BB133111EBull;
+    return InValue ^ (InValue >> 31);
+}
+
+float URRFleetDriveManager::StreamGaussian(const uint64 InStream, const uint64 InCounter)
+{
+    // Two 53-bit uniforms hashed from (stream, counter), then Box-Muller
+    const uint64 bits1 = SplitMix64(SplitMix64(InStream) ^ InCounter);
+    const uint64 bits2 = SplitMix64(bits1);
+    const double u1 = ((bits1 >> 11) + 1) * (1.0 / 9007199254740993.0);    // (0, 1]
+    const double u2 = (bits2 >> 11) * (1.0 / 9007199254740992.0);          // [0, 1)
+    return static_cast<float>(FMath::Sqrt(-2.0 * FMath::Loge(u1)) * FMath::Cos(UE_DOUBLE_TWO_PI * u2));
+}
+
+bool URRFleetDriveManager::RegisterDrive(UDifferentialDriveComponent* InDrive)
+{
+    if ((nullptr == InDrive) || Drives.Contains(InDrive))
+    {
+        return false;
+    }
+    Drives.Add(InDrive);
+
+    // Stream id keyed by the drive's owner & own names, thus independent from the registration order
+    const AActor* owner = InDrive->GetOwner();
+    const FString driveKey = FString::Printf(TEXT("%s.%s"), owner ? *owner->GetName() : TEXT(""), *InDrive->GetName());
+    const uint64 driveKeyHash = CityHash64(reinterpret_cast<const char*>(*driveKey), driveKey.Len() * sizeof(TCHAR));
+    NoiseStreams.Add(SplitMix64(SplitMix64(static_cast<uint64>(NoiseSeed)) ^ driveKeyHash));
+    NoiseCounters.Add(0);
+    return true;
+}
+
+void URRFleetDriveManager::UnregisterDrive(UDifferentialDriveComponent* InDrive)
+{
+    const int32 driveIndex = Drives.IndexOfByKey(InDrive);
+    if (INDEX_NONE != driveIndex)
+    {
+        Drives.RemoveAtSwap(driveIndex);
+        NoiseStreams.RemoveAtSwap(driveIndex);
+        NoiseCounters.RemoveAtSwap(driveIndex);
+    }
+}
+
+void URRFleetDriveManager::Tick(float InDeltaTime)
+{
+    IntegrateOdom(InDeltaTime);
+}
+
+void URRFleetDriveManager::IntegrateOdom(float InDeltaTime)
+{
+    if ((0 == Drives.Num()) || (InDeltaTime < 1e-9f))
+    {
+        return;
+    }
+
+    // 1- Gather drive commands & odom states, on game thread
+    for (int32 i = Drives.Num() - 1; i >= 0; --i)
+    {
+        if (false == Drives[i].IsValid())
+        {
+            Drives.RemoveAtSwap(i);
+            NoiseStreams.RemoveAtSwap(i);
+            NoiseCounters.RemoveAtSwap(i);
+        }
+    }
+    const int32 drivesNum = Drives.Num();
+    for (auto* buffer : {&WheelVelsL,
+                         &WheelVelsR,
+                         &WheelSeparationHalves,
+                         &NoiseMeans,
+                         &NoiseStdDevs,
+                         &PosesX,
+                         &PosesY,
+                         &PosesThetaRad,
+                         &TwistsLinear,
+                         &TwistsAngular})
+    {
+        buffer->SetNumUninitialized(drivesNum, false);
+    }
+    PoseChanged.SetNumUninitialized(drivesNum, false);
+
+    for (int32 i = 0; i < drivesNum; ++i)
+    {
+        UDifferentialDriveComponent* drive = Drives[i].Get();
+        URRBaseOdomComponent* odomComp = drive->OdomComponent;
+        if ((nullptr == odomComp) || (drive->ShouldSkipUpdate(InDeltaTime)))
+        {
+            // Zero separation marks the drive as skipped
+            WheelSeparationHalves[i] = 0.f;
+            continue;
+        }
+        if (false == odomComp->bIsOdomInitialized)
+        {
+            drive->InitEncoderOdom();
+        }
+
+        const float angularVelRad = FMath::DegreesToRadians(drive->AngularVelocity.Z);
+        WheelVelsL[i] = drive->Velocity.X + angularVelRad * drive->WheelSeparationHalf;
+        WheelVelsR[i] = drive->Velocity.X - angularVelRad * drive->WheelSeparationHalf;
+        WheelSeparationHalves[i] = drive->WheelSeparationHalf;
+        NoiseMeans[i] = odomComp->bWithNoise ? odomComp->NoiseMeanPos : 0.f;
+        NoiseStdDevs[i] = odomComp->bWithNoise ? odomComp->NoiseVariancePos : 0.f;
+        PosesX[i] = drive->PoseEncoderX;
+        PosesY[i] = drive->PoseEncoderY;
+        PosesThetaRad[i] = drive->PoseEncoderThetaRad;
+    }
+
+    // 2- Integrate all drives at once. Noise is added as a component of wheel vels, as per Sigwart 2011 Autonomous Mobile Robots
+    ParallelFor(
+        drivesNum,
+        [this, InDeltaTime](int32 InDriveIndex)
+        {
+            const float separationHalf = WheelSeparationHalves[InDriveIndex];
+            if (separationHalf <= 0.f)
+            {
+                PoseChanged[InDriveIndex] = false;
+                return;
+            }
+
+            const uint64 stream = NoiseStreams[InDriveIndex];
+            const uint64 counter = NoiseCounters[InDriveIndex];
+            float noiseL = 0.f;
+            float noiseR = 0.f;
+            if (NoiseStdDevs[InDriveIndex] > 0.f || NoiseMeans[InDriveIndex] != 0.f)
+            {
+                noiseL = NoiseMeans[InDriveIndex] + NoiseStdDevs[InDriveIndex] * StreamGaussian(stream, counter);
+                noiseR = NoiseMeans[InDriveIndex] + NoiseStdDevs[InDriveIndex] * StreamGaussian(stream, counter + 1);
+            }
+            const float sl = (WheelVelsL[InDriveIndex] + noiseL) * InDeltaTime;
+            const float sr = (WheelVelsR[InDriveIndex] + noiseR) * InDeltaTime;
+            const float ssum = sl + sr;
+            const float sdiff = sr - sl;
+
+            const float heading = PosesThetaRad[InDriveIndex] + sdiff / (4.f * separationHalf);
+            const float dx = ssum * .5f * FMath::Cos(heading);
+            const float dy = ssum * .5f * FMath::Sin(heading);
+            const float dtheta = -sdiff / (2.f * separationHalf);
+
+            PosesX[InDriveIndex] += dx;
+            PosesY[InDriveIndex] += dy;
+            PosesThetaRad[InDriveIndex] += dtheta;
+            TwistsLinear[InDriveIndex] = FMath::Sqrt(dx * dx + dy * dy) / InDeltaTime;
+            TwistsAngular[InDriveIndex] = dtheta / InDeltaTime;
+            PoseChanged[InDriveIndex] = (0.f != sl) || (0.f != sr);
+        },
+        (drivesNum < MinBatchSize) ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    // 3- Write back, on game thread
+    const FROSTime stamp = URRConversionUtils::FloatToROSStamp(UGameplayStatics::GetTimeSeconds(GetWorld()));
+    for (int32 i = 0; i < drivesNum; ++i)
+    {
+        if (WheelSeparationHalves[i] <= 0.f)
+        {
+            continue;
+        }
+        NoiseCounters[i] += 2;
+
+        UDifferentialDriveComponent* drive = Drives[i].Get();
+        FROSOdom& odomData = drive->OdomComponent->OdomData;
+        odomData.Header.Stamp = stamp;
+        odomData.Twist.Twist.Linear = FVector(TwistsLinear[i], 0.f, 0.f);
+        odomData.Twist.Twist.Angular = FVector(0.f, 0.f, TwistsAngular[i]);
+        if (PoseChanged[i])
+        {
+            drive->PoseEncoderX = PosesX[i];
+            drive->PoseEncoderY = PosesY[i];
+            drive->PoseEncoderThetaRad = PosesThetaRad[i];
+            odomData.Pose.Pose.Position = FVector(PosesX[i], PosesY[i], 0.f);
+            odomData.Pose.Pose.Orientation = FQuat(FVector::ZAxisVector, PosesThetaRad[i]);
+        }
+    }
+}
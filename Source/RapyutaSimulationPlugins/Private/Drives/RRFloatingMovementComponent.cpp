@@ -2,11 +2,19 @@
 
 #include "Drives/RRFloatingMovementComponent.h"
 
+// UE
+#include "NavigationSystem.h"
+
 // RapyutaSimulationPlugins
 #include "Core/RRMathUtils.h"
 
 URRFloatingMovementComponent::URRFloatingMovementComponent(const FObjectInitializer& ObjectInitializer)
-    : Super(ObjectInitializer), bSweepEnabled(true), b2DMovement(false), bUseDecelerationForPaths(true)
+    : Super(ObjectInitializer),
+      bSweepEnabled(true),
+      b2DMovement(false),
+      bUseDecelerationForPaths(true),
+      bPlanarNavMeshMovement(false),
+      bHasNavMeshProjection(false)
 {
 }
 
@@ -73,6 +81,14 @@ void URRFloatingMovementComponent::TickComponent(float InDeltaTime,
     FRotator deltaRot = FRotator::MakeFromEuler(AngularVelocity) * InDeltaTime;
     if ((!deltaLoc.IsNearlyZero(1e-6f)) || (!deltaRot.IsNearlyZero(1e-3f)))
     {
+        if (bPlanarNavMeshMovement &&
+            MovePlanarOnNavMesh(
+                deltaLoc, FQuat(deltaRot).GetNormalized() * UpdatedComponent->GetComponentQuat().GetNormalized(), InDeltaTime))
+        {
+            UpdateComponentVelocity();
+            return;
+        }
+
         // Save prevLocation
         const FVector prevLocation = UpdatedComponent->GetComponentLocation();
         // Scope for setting move flags & restoring it after movement
@@ -136,6 +152,79 @@ void URRFloatingMovementComponent::TickComponent(float InDeltaTime,
     UpdateComponentVelocity();
 }
 
+bool URRFloatingMovementComponent::MovePlanarOnNavMesh(const FVector& InDeltaLoc, const FQuat& InNewQuat, float InDeltaTime)
+{
+    UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (nullptr == navSys)
+    {
+        return false;
+    }
+
+    const FVector prevLocation = UpdatedComponent->GetComponentLocation();
+    if (false == bHasNavMeshProjection)
+    {
+        FNavLocation navLocation;
+        if (false == navSys->ProjectPointToNavigation(prevLocation, navLocation, FVector(1.f, 1.f, NavMeshProjectionHeight)))
+        {
+            return false;
+        }
+        NavMeshHeightOffset = prevLocation.Z - navLocation.Location.Z;
+        LastNavMeshProjectedLocation = navLocation.Location;
+        bHasNavMeshProjection = true;
+    }
+
+    // Navmesh edges block the agent's planar motion, inflated by its radius
+    const FVector planarDeltaLoc(InDeltaLoc.X, InDeltaLoc.Y, 0.f);
+    const FVector navStart(prevLocation.X, prevLocation.Y, prevLocation.Z - NavMeshHeightOffset);
+    FVector navTarget = navStart + planarDeltaLoc;
+    const float moveDistance = planarDeltaLoc.Size();
+    if (moveDistance > UE_KINDA_SMALL_NUMBER)
+    {
+        const FVector moveDir = planarDeltaLoc / moveDistance;
+        const float agentRadius = (NavAgentProps.AgentRadius > 0.f)
+                                      ? NavAgentProps.AgentRadius
+                                      : FMath::Max(UpdatedComponent->Bounds.BoxExtent.X, UpdatedComponent->Bounds.BoxExtent.Y);
+        FVector hitLocation;
+        if (UNavigationSystemV1::NavigationRaycast(
+                GetWorld(), navStart, navTarget + moveDir * agentRadius, hitLocation, nullptr, PawnOwner->GetController()))
+        {
+            navTarget = navStart + moveDir * FMath::Max(FVector::Dist2D(navStart, hitLocation) - agentRadius, 0.f);
+        }
+    }
+
+    // Re-project onto the navmesh & check penetration into static geometry only once moved far enough
+    if (FVector::DistSquared2D(navTarget, LastNavMeshProjectedLocation) > FMath::Square(NavMeshProjectionDistance))
+    {
+        FNavLocation navLocation;
+        if (false == navSys->ProjectPointToNavigation(navTarget, navLocation, FVector(1.f, 1.f, NavMeshProjectionHeight)))
+        {
+            bHasNavMeshProjection = false;
+            return false;
+        }
+        navTarget.Z = navLocation.Location.Z;
+        LastNavMeshProjectedLocation = navLocation.Location;
+
+        // Slightly shrunk shape, not to overlap the floor it stands on
+        if (UpdatedPrimitive && OverlapTest(navTarget + FVector(0.f, 0.f, NavMeshHeightOffset),
+                                            InNewQuat,
+                                            UpdatedPrimitive->GetCollisionObjectType(),
+                                            UpdatedPrimitive->GetCollisionShape(-2.f),
+                                            PawnOwner))
+        {
+            bHasNavMeshProjection = false;
+            return false;
+        }
+    }
+    else
+    {
+        navTarget.Z = LastNavMeshProjectedLocation.Z;
+    }
+
+    MoveUpdatedComponent(navTarget + FVector(0.f, 0.f, NavMeshHeightOffset) - prevLocation, InNewQuat, false);
+    Velocity = (UpdatedComponent->GetComponentLocation() - prevLocation) / InDeltaTime;
+    return true;
+}
+
 FVector URRFloatingMovementComponent::GetPenetrationAdjustment(const FHitResult& InHit) const
 {
     if (!InHit.bStartPenetrating)
@@ -132,111 +132,198 @@ void URobotVehicleMovementComponent::UpdateMovement(float InDeltaTime)
 
     if (bAdaptToSurfaceBelow)
     {
-        // check for floor configuration beneath the robot : slopes, etc
-        AActor* owner = GetOwner();
-        FCollisionQueryParams traceParams = FCollisionQueryParams(FName(TEXT("Contact_Trace")), true, owner);
-        traceParams.bReturnPhysicalMaterial = true;
-        traceParams.bTraceComplex = true;
-        traceParams.bReturnFaceIndex = true;
-        traceParams.AddIgnoredActor(owner);
-
-        // If few contact points defined, cast a single ray beneath the robot to get the floor orientation
-        if (ContactPoints.Num() < 3)
+        AdaptToSurfaceBelow(InDeltaTime);
+    }
+}
+
+void URobotVehicleMovementComponent::TraceFloor(const TArray<FVector, TInlineAllocator<8>>& InRayOrigins,
+                                                TArray<FHitResult, TInlineAllocator<8>>& OutHits)
+{
+    UWorld* world = GetWorld();
+    const int32 raysNum = InRayOrigins.Num();
+    OutHits.SetNum(raysNum);
+
+    // Async traces requested last tick are only reusable if the rays are still the same
+    const bool bUseAsyncResults = bAsyncFloorTrace && (FloorTraceHandles.Num() == raysNum);
+    for (int32 i = 0; i < raysNum; ++i)
+    {
+        const FVector startPos = InRayOrigins[i] + FVector(0.f, 0.f, RayOffsetUp);
+        const FVector endPos = InRayOrigins[i] - FVector(0.f, 0.f, RayOffsetDown);
+        FHitResult& hit = OutHits[i];
+
+        FTraceDatum traceData;
+        if (bUseAsyncResults && world->QueryTraceData(FloorTraceHandles[i], traceData))
         {
-            // robot will be oriented as the normal vector in floor plane
-            FVector startPos = owner->GetActorLocation() + FVector(0., 0., RayOffsetUp);
-            FVector endPos = owner->GetActorLocation() - FVector(0., 0., RayOffsetDown);
-            bool bIsFloorHit = GetWorld()->LineTraceSingleByChannel(hit,
-                                                                    startPos,
-                                                                    endPos,
-                                                                    ECollisionChannel::ECC_Visibility,
-                                                                    traceParams,
-                                                                    FCollisionResponseParams::DefaultResponseParam);
-            if (bIsFloorHit)
+            const FHitResult* asyncHit = FHitResult::GetFirstBlockingHit(traceData.OutHits);
+            if (asyncHit)
             {
-                FVector forwardProjection = FVector::VectorPlaneProject(owner->GetActorForwardVector(), hit.ImpactNormal);
-                owner->SetActorRotation(UKismetMathLibrary::MakeRotFromXZ(forwardProjection, hit.ImpactNormal));
-                if (MovingPlatform == nullptr)
-                {
-                    FVector heightVariation = {0., 0., MinDistanceToFloor - hit.Distance};
-                    owner->AddActorWorldOffset(heightVariation, true, &hit, ETeleportType::None);
-                }
+                // Project last tick's floor impact onto the current ray
+                hit = *asyncHit;
+                hit.ImpactPoint = FVector(startPos.X, startPos.Y, asyncHit->ImpactPoint.Z);
+                hit.Distance = startPos.Z - asyncHit->ImpactPoint.Z;
             }
             else
             {
-                // very basic robot falling
-                owner->AddActorWorldOffset(FVector(0., 0., -FallingSpeed * InDeltaTime), true, &hit, ETeleportType::None);
+                // Last tick's trace has really found no floor
+                hit.Init(startPos, endPos);
             }
         }
         else
         {
-            // compute all impact points and keep the 3 closest
-            // get the normal vector of the plane formed by these 3 points
-            FVector contacts[3];
-            float contactsDistance[3];
-            uint8 nbContact = 0;
+            // Sync trace, also used for the first async tick & whenever last tick's result is not available
+            hit.Init(startPos, endPos);
+            world->LineTraceSingleByChannel(hit,
+                                            startPos,
+                                            endPos,
+                                            ECollisionChannel::ECC_Visibility,
+                                            FloorTraceParams,
+                                            FCollisionResponseParams::DefaultResponseParam);
+        }
+    }
 
-            for (USceneComponent* contact : ContactPoints)
-            {
-                // get the contact points
-                FVector startPos = contact->GetComponentLocation() + FVector(0.f, 0.f, RayOffsetUp);
-                FVector endPos = contact->GetComponentLocation() - FVector(0.f, 0.f, RayOffsetDown);
-                bool bIsFloorHit = GetWorld()->LineTraceSingleByChannel(hit,
-                                                                        startPos,
-                                                                        endPos,
-                                                                        ECollisionChannel::ECC_Visibility,
-                                                                        traceParams,
-                                                                        FCollisionResponseParams::DefaultResponseParam);
-                if (!bIsFloorHit)
-                {
-                    // if no impact below, just consider this contact point is falling
-                    hit.ImpactPoint = contact->GetComponentLocation() - FVector(0.f, 0.f, FallingSpeed * InDeltaTime);
-                    hit.Distance = RayOffsetUp + FallingSpeed * InDeltaTime;
-                }
+    if (bAsyncFloorTrace)
+    {
+        // Request next tick's traces, which are batched with other vehicles' & run in parallel by the engine
+        FloorTraceHandles.SetNum(raysNum);
+        for (int32 i = 0; i < raysNum; ++i)
+        {
+            FloorTraceHandles[i] = world->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+                                                                  InRayOrigins[i] + FVector(0.f, 0.f, RayOffsetUp),
+                                                                  InRayOrigins[i] - FVector(0.f, 0.f, RayOffsetDown),
+                                                                  ECollisionChannel::ECC_Visibility,
+                                                                  FloorTraceParams,
+                                                                  FCollisionResponseParams::DefaultResponseParam);
+        }
+    }
+    else
+    {
+        FloorTraceHandles.Reset();
+    }
+}
 
-                // keep only the 3 contacts with shortest distances
-                if (nbContact < 3)
-                {
-                    contacts[nbContact] = hit.ImpactPoint;
-                    contactsDistance[nbContact] = hit.Distance;
-                    nbContact++;
-                }
-                else
-                {
-                    uint8 maxContactDistanceIndex = 0;
-                    if (contactsDistance[1] > contactsDistance[0])
-                        maxContactDistanceIndex = 1;
-                    if (contactsDistance[2] > contactsDistance[maxContactDistanceIndex])
-                        maxContactDistanceIndex = 2;
-                    if (hit.Distance < contactsDistance[maxContactDistanceIndex])
-                    {
-                        contactsDistance[maxContactDistanceIndex] = hit.Distance;
-                        contacts[maxContactDistanceIndex] = hit.ImpactPoint;
-                    }
-                }
-            }
+void URobotVehicleMovementComponent::AdaptToSurfaceBelow(float InDeltaTime)
+{
+    // check for floor configuration beneath the robot : slopes, etc
+    AActor* owner = GetOwner();
+    const bool bSingleRay = (ContactPoints.Num() < 3);
 
-            // get the normal vector of the plane going through these 3 points
-            FVector planeNormal = FVector::CrossProduct(contacts[1] - contacts[0], contacts[2] - contacts[0]);
-            planeNormal.Normalize(0.01f);
-            if (planeNormal.Z < 0.f)
-                planeNormal = -planeNormal;
+    // Gather all rays, then trace them at once
+    TArray<FVector, TInlineAllocator<8>> rayOrigins;
+    if (bSingleRay)
+    {
+        rayOrigins.Add(owner->GetActorLocation());
+    }
+    else
+    {
+        for (const USceneComponent* contact : ContactPoints)
+        {
+            rayOrigins.Add(contact->GetComponentLocation());
+        }
+    }
+    TArray<FHitResult, TInlineAllocator<8>> hits;
+    TraceFloor(rayOrigins, hits);
 
-            FVector ForwardProjection = FVector::VectorPlaneProject(owner->GetActorForwardVector(), planeNormal);
-            owner->SetActorRotation(UKismetMathLibrary::MakeRotFromXZ(ForwardProjection, planeNormal));
+    // New pose, applied once at the end
+    FVector newLocation = owner->GetActorLocation();
+    FQuat newRotation = owner->GetActorQuat();
+    bool bSweep = false;
 
+    // If few contact points defined, cast a single ray beneath the robot to get the floor orientation
+    if (bSingleRay)
+    {
+        // robot will be oriented as the normal vector in floor plane
+        const FHitResult& hit = hits[0];
+        bSweep = true;
+        if (hit.bBlockingHit)
+        {
+            FVector forwardProjection = FVector::VectorPlaneProject(owner->GetActorForwardVector(), hit.ImpactNormal);
+            newRotation = UKismetMathLibrary::MakeRotFromXZ(forwardProjection, hit.ImpactNormal).Quaternion();
             if (MovingPlatform == nullptr)
             {
-                // Moves the robot up or down, depending on impact position
-                float minDistance = *Algo::MinElement(contactsDistance);
-                minDistance -= RayOffsetUp;
-                minDistance = FMath::Min(minDistance, FallingSpeed * InDeltaTime);
+                newLocation.Z += MinDistanceToFloor - hit.Distance;
+            }
+        }
+        else
+        {
+            // very basic robot falling
+            newLocation.Z -= FallingSpeed * InDeltaTime;
+        }
+    }
+    else
+    {
+        // compute all impact points and keep the 3 closest
+        // get the normal vector of the plane formed by these 3 points
+        FVector contacts[3];
+        float contactsDistance[3];
+        uint8 nbContact = 0;
 
-                FVector heightVariation = {0., 0., -minDistance};
-                owner->AddActorWorldOffset(heightVariation, false, &hit, ETeleportType::None);
+        for (int32 i = 0; i < hits.Num(); ++i)
+        {
+            FHitResult& hit = hits[i];
+            if (!hit.bBlockingHit)
+            {
+                // if no impact below, just consider this contact point is falling
+                hit.ImpactPoint = rayOrigins[i] - FVector(0.f, 0.f, FallingSpeed * InDeltaTime);
+                hit.Distance = RayOffsetUp + FallingSpeed * InDeltaTime;
+            }
+
+            // keep only the 3 contacts with shortest distances
+            if (nbContact < 3)
+            {
+                contacts[nbContact] = hit.ImpactPoint;
+                contactsDistance[nbContact] = hit.Distance;
+                nbContact++;
+            }
+            else
+            {
+                uint8 maxContactDistanceIndex = 0;
+                if (contactsDistance[1] > contactsDistance[0])
+                    maxContactDistanceIndex = 1;
+                if (contactsDistance[2] > contactsDistance[maxContactDistanceIndex])
+                    maxContactDistanceIndex = 2;
+                if (hit.Distance < contactsDistance[maxContactDistanceIndex])
+                {
+                    contactsDistance[maxContactDistanceIndex] = hit.Distance;
+                    contacts[maxContactDistanceIndex] = hit.ImpactPoint;
+                }
             }
         }
+
+        // get the normal vector of the plane going through these 3 points
+        FVector planeNormal = FVector::CrossProduct(contacts[1] - contacts[0], contacts[2] - contacts[0]);
+        planeNormal.Normalize(0.01f);
+        if (planeNormal.Z < 0.f)
+            planeNormal = -planeNormal;
+
+        FVector ForwardProjection = FVector::VectorPlaneProject(owner->GetActorForwardVector(), planeNormal);
+        newRotation = UKismetMathLibrary::MakeRotFromXZ(ForwardProjection, planeNormal).Quaternion();
+
+        if (MovingPlatform == nullptr)
+        {
+            // Moves the robot up or down, depending on impact position
+            float minDistance = *Algo::MinElement(contactsDistance);
+            minDistance -= RayOffsetUp;
+            minDistance = FMath::Min(minDistance, FallingSpeed * InDeltaTime);
+            newLocation.Z -= minDistance;
+        }
     }
+
+    FHitResult moveHit;
+    if (bSweep)
+    {
+        // Only the height offset is swept, not the rotation
+        owner->SetActorRotation(newRotation);
+        owner->AddActorWorldOffset(newLocation - owner->GetActorLocation(), true, &moveHit, ETeleportType::None);
+    }
+    else
+    {
+        // Single transform update, instead of separate rotation & offset ones
+        owner->SetActorLocationAndRotation(newLocation, newRotation, false, &moveHit, ETeleportType::None);
+    }
+}
+
+void URobotVehicleMovementComponent::SerializeDriveState(FArchive& InOutAr)
+{
 }
 
 void URobotVehicleMovementComponent::InitData()
@@ -252,14 +339,15 @@ void URobotVehicleMovementComponent::InitData()
     UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("Nb Contact Points : %d"), ContactPoints.Num());
 #endif
 
+    // Floor trace params, lean by default since only impact point, normal & distance are used
+    FloorTraceParams = FCollisionQueryParams(FName(TEXT("Contact_Trace")), bTraceComplexFloor, owner);
+    FloorTraceParams.bReturnPhysicalMaterial = bReturnFloorHitDetails;
+    FloorTraceParams.bReturnFaceIndex = bReturnFloorHitDetails;
+    FloorTraceParams.AddIgnoredActor(owner);
+    FloorTraceHandles.Reset();
+
     // Compute the starting distance between the robot root and the floor
     // We consider that the robot is on a horizontal floor at the beginning
-    FCollisionQueryParams traceParams = FCollisionQueryParams(FName(TEXT("Contact_Trace")), true, owner);
-    traceParams.bReturnPhysicalMaterial = true;
-    traceParams.bTraceComplex = true;
-    traceParams.bReturnFaceIndex = true;
-    traceParams.AddIgnoredActor(owner);
-
     FVector startPos = owner->GetActorLocation() + FVector(0.f, 0.f, 10.f);
     FVector endPos = owner->GetActorLocation() - FVector(0.f, 0.f, 50.f);
     FHitResult hitResult;
@@ -267,7 +355,7 @@ void URobotVehicleMovementComponent::InitData()
                                                             startPos,
                                                             endPos,
                                                             ECollisionChannel::ECC_Visibility,
-                                                            traceParams,
+                                                            FloorTraceParams,
                                                             FCollisionResponseParams::DefaultResponseParam);
     if (bIsFloorHit)
     {
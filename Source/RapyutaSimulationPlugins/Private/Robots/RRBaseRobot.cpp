@@ -21,7 +21,7 @@
 #include "Robots/RRRobotROS2Interface.h"
 #include "Sensors/RRROS2BaseSensorComponent.h"
 #include "Tools/SimulationState.h"
-#include "UI/RRUserWidget.h"
+#include "UI/RRRobotLabelsOverlay.h"
 
 // Others
 #include "Json.h"
@@ -440,7 +440,15 @@ void ARRBaseRobot::SyncServerLinearMovement(float InClientTimeStamp,
     auto* npc = Cast<ARRNetworkPlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
     if (npc != nullptr)
     {
-        npc->ServerSetLinearVel(ServerRobot, InClientTimeStamp, InClientRobotTransform, InLinearVel);
+        if (npc->bCoalesceRobotVelCommands)
+        {
+            // Coalesced with the angular one, thus sent along with the current target angular vel
+            npc->QueueRobotVelCommand(ServerRobot, InClientTimeStamp, InClientRobotTransform, InLinearVel, TargetAngularVel);
+        }
+        else
+        {
+            npc->ServerSetLinearVel(ServerRobot, InClientTimeStamp, InClientRobotTransform, InLinearVel);
+        }
     }
 }
 
@@ -461,7 +469,16 @@ void ARRBaseRobot::SyncServerAngularMovement(float InClientTimeStamp,
     auto* npc = Cast<ARRNetworkPlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
     if (npc != nullptr)
     {
-        npc->ServerSetAngularVel(ServerRobot, InClientTimeStamp, InClientRobotRotation, InAngularVel);
+        if (npc->bCoalesceRobotVelCommands)
+        {
+            // Coalesced with the linear one, thus sent along with the current target linear vel
+            npc->QueueRobotVelCommand(
+                ServerRobot, InClientTimeStamp, FTransform(InClientRobotRotation, GetActorLocation()), TargetLinearVel, InAngularVel);
+        }
+        else
+        {
+            npc->ServerSetAngularVel(ServerRobot, InClientTimeStamp, InClientRobotRotation, InAngularVel);
+        }
     }
 }
 
@@ -491,33 +508,17 @@ void ARRBaseRobot::SetLocalAngularVel(const FVector& InAngularVel)
 
 void ARRBaseRobot::InitUIWidget()
 {
-    UIWidgetComp = URRUObjectUtils::CreateAndAttachChildComponent<UWidgetComponent>(
-        this, *FString::Printf(TEXT("%sUIWidget"), *GetName()), UIWidgetOffset);
-
-    // 1- Set [WidgetClass] as [URRUserWidget]
-    UIWidgetComp->SetWidgetClass(URRUserWidget::StaticClass());
-
-    // 1.1 - Init [UIWidgetComp]
-    UIWidgetComp->InitWidget();
-    UIWidgetComp->SetDrawSize(FIntPoint(500.f, 50.f));
-    UIWidgetComp->SetPivot(FVector2D::ZeroVector);
-    UIWidgetComp->SetCanEverAffectNavigation(false);
-    UIWidgetComp->SetTwoSided(true);
-    // NOTE: Using Screen widget space, [UIWidgetComp] will be always facing user view, thus no need to manually orientate it per Tick
-    UIWidgetComp->SetWidgetSpace(EWidgetSpace::Screen);
-
-    // 1.2 - Save [UIWidgetComp]'s widget into [UIUserWidget]
-    UIUserWidget = Cast<URRUserWidget>(UIWidgetComp->GetWidget());
-    UIUserWidget->OwnerWidgetComponent = UIWidgetComp;
-
-    // 2- Add [UIUserWidget] to viewport with robot's name as initial text
-    UIUserWidget->AddToViewport();
-    UIUserWidget->SetLabelText(GetName());
+    // A single overlay draws all robots' labels, instead of one screen-space widget component per robot
+    if (URRRobotLabelsOverlay* labelsOverlay = GetWorld()->GetSubsystem<URRRobotLabelsOverlay>())
+    {
+        labelsOverlay->AddLabel(this, GetName(), UIWidgetOffset.GetLocation());
+    }
 }
 
 bool ARRBaseRobot::CheckUIUserWidget() const
 {
-    if (UIUserWidget)
+    const URRRobotLabelsOverlay* labelsOverlay = GetWorld() ? GetWorld()->GetSubsystem<URRRobotLabelsOverlay>() : nullptr;
+    if (labelsOverlay && labelsOverlay->HasLabel(this))
     {
         return true;
     }
@@ -525,11 +526,11 @@ bool ARRBaseRobot::CheckUIUserWidget() const
     {
         if (bUIWidgetEnabled)
         {
-            UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Has [bUIWidgetEnabled] ON but NULL UIUserWidget"));
+            UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Has [bUIWidgetEnabled] ON but no registered label"));
         }
         else
         {
-            UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("Requires [bUIWidgetEnabled] to use UIUserWidget"));
+            UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("Requires [bUIWidgetEnabled] to use label"));
         }
         return false;
     }
@@ -539,15 +540,15 @@ void ARRBaseRobot::SetTooltipText(const FString& InTooltip)
 {
     if (CheckUIUserWidget())
     {
-        UIUserWidget->SetLabelText(InTooltip);
+        GetWorld()->GetSubsystem<URRRobotLabelsOverlay>()->SetLabelText(this, InTooltip);
     }
 }
 
 void ARRBaseRobot::SetTooltipVisible(bool bInTooltipVisible)
 {
-    if (CheckUIUserWidget() && UIUserWidget->TextBlock)
+    if (CheckUIUserWidget())
     {
-        UIUserWidget->TextBlock->SetVisibility(bInTooltipVisible ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+        GetWorld()->GetSubsystem<URRRobotLabelsOverlay>()->SetLabelTextVisible(this, bInTooltipVisible);
     }
 }
 
@@ -555,7 +556,7 @@ void ARRBaseRobot::SetUIWidgetVisible(bool bInWidgetVisible)
 {
     if (CheckUIUserWidget())
     {
-        UIUserWidget->SetVisibility(bInWidgetVisible ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+        GetWorld()->GetSubsystem<URRRobotLabelsOverlay>()->SetLabelVisible(this, bInWidgetVisible);
     }
 }
 
@@ -3,6 +3,7 @@
 #include "Robots/RRBaseRobotROSController.h"
 
 // RapyutaSimulationPlugins
+#include "Core/RRCrowdSignificanceManager.h"
 #include "Robots/RRBaseRobot.h"
 #include "Robots/RRRobotROS2Interface.h"
 
@@ -14,6 +15,13 @@ void ARRBaseRobotROSController::OnPossess(APawn* InPawn)
     if (robot)
     {
         robot->InitROS2Interface();
+
+        // Crowd agents near this robot are significant
+        auto* significanceManager = GetWorld()->GetSubsystem<URRCrowdSignificanceManager>();
+        if (significanceManager)
+        {
+            significanceManager->RegisterObserver(robot);
+        }
     }
     else
     {
@@ -26,6 +34,11 @@ void ARRBaseRobotROSController::OnUnPossess()
     auto* robot = GetPawn<ARRBaseRobot>();
     if (robot)
     {
+        auto* significanceManager = GetWorld()->GetSubsystem<URRCrowdSignificanceManager>();
+        if (significanceManager)
+        {
+            significanceManager->UnregisterObserver(robot);
+        }
         robot->DeInitROS2Interface();
     }
     else
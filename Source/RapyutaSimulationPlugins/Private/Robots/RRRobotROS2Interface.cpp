@@ -19,6 +19,7 @@
 #include "Core/RRConversionUtils.h"
 #include "Core/RRGeneralUtils.h"
 #include "Robots/RRBaseRobot.h"
+#include "Tools/RRCommandRecorder.h"
 
 void URRRobotROS2Interface::Initialize(ARRBaseRobot* InRobot)
 {
@@ -163,6 +164,17 @@ void URRRobotROS2Interface::StopPublishers()
     }
 }
 
+void URRRobotROS2Interface::StartPublishers()
+{
+    for (auto& pub : Publishers)
+    {
+        if (pub.Value != nullptr)
+        {
+            pub.Value->StartPublishTimer();
+        }
+    }
+}
+
 bool URRRobotROS2Interface::InitSubscriptions()
 {
     if (false == IsValid(RobotROS2Node))
@@ -307,8 +319,18 @@ void URRRobotROS2Interface::MovementCallback(const UROS2GenericMsg* Msg)
                   {
                       if (IsValid(Robot))
                       {
+                          // Live commands are ignored while replaying recorded ones
+                          URRCommandRecorder* recorder = Robot->GetWorld()->GetSubsystem<URRCommandRecorder>();
+                          if (recorder && recorder->IsReplaying())
+                          {
+                              return;
+                          }
                           Robot->SetLinearVel(linear);
                           Robot->SetAngularVel(angular);
+                          if (recorder)
+                          {
+                              recorder->RecordCmdVel(Robot, linear, angular);
+                          }
                       }
                   });
     }
@@ -411,7 +433,16 @@ void URRRobotROS2Interface::JointStateCallback(const UROS2GenericMsg* Msg)
                               LogRapyutaCore, Warning, TEXT("Robot is nullptr. RobotROS2Interface::Robot must not be nullptr."));
                           return;
                       }
+                      URRCommandRecorder* recorder = Robot->GetWorld()->GetSubsystem<URRCommandRecorder>();
+                      if (recorder && recorder->IsReplaying())
+                      {
+                          return;
+                      }
                       Robot->SetJointState(joints, jointControlType);
+                      if (recorder)
+                      {
+                          recorder->RecordJointState(Robot, joints, jointControlType);
+                      }
                   });
     }
 }
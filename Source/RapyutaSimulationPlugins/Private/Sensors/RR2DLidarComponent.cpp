@@ -15,6 +15,8 @@ void URR2DLidarComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 #if TRACE_ASYNC
     verify(TraceHandles.Num() == RecordedHits.Num());
     UWorld* world = GetWorld();
+    bool bReceivedHits = false;
+    bool bScanCompleted = true;
     for (auto i = 0; i < TraceHandles.Num(); ++i)
     {
         FTraceHandle& traceHandle = TraceHandles[i];
@@ -25,6 +27,7 @@ void URR2DLidarComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 
             if (world->QueryTraceData(traceHandle, Output))
             {
+                bReceivedHits = true;
                 if (Output.OutHits.Num() > 0)
                 {
                     traceHandle._Data.FrameNumber = 0;
@@ -39,8 +42,15 @@ void URR2DLidarComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
                     recordedHit.TraceEnd = Output.End;
                 }
             }
+            bScanCompleted &= (traceHandle._Data.FrameNumber == 0);
         }
     }
+
+    // Hit actors are only updated once the whole scan has completed, for #Visible
+    if (bReceivedHits && bScanCompleted)
+    {
+        UpdateScanHitActors();
+    }
 #endif
 }
 
@@ -114,6 +124,7 @@ void URR2DLidarComponent::SensorUpdate()
                 RecordedHits[Index], startPos, endPos, ECC_Visibility, TraceParams, FCollisionResponseParams::DefaultResponseParam);
         },
         false);
+    UpdateScanHitActors();
 #endif
 
     if (BWithNoise)
@@ -134,7 +145,7 @@ void URR2DLidarComponent::SensorUpdate()
     }
 
     TimeOfLastScan = UGameplayStatics::GetTimeSeconds(GetWorld());
-    Dt = 1.f / static_cast<float>(PublicationFrequencyHz);
+    Dt = (CurrentPublicationFrequencyHz > 0) ? (1.f / static_cast<float>(CurrentPublicationFrequencyHz)) : 0.f;
 
     // need to store on a structure associating hits with time?
     // GetROS2Data needs to get all data since the last Get? or the last within the last time interval?
@@ -216,53 +227,21 @@ void URR2DLidarComponent::SensorUpdate()
     }
 }
 
-bool URR2DLidarComponent::Visible(AActor* TargetActor)
+bool URR2DLidarComponent::IsInScanFOV(const FVector& InLocalCenter, const float InRadius) const
 {
-    TArray<FHitResult> RecordedVizHits;
-    RecordedVizHits.Init(FHitResult(ForceInit), NSamplesPerScan);
-
-    DHAngle = FOVHorizontal / static_cast<float>(NSamplesPerScan);
-
-    // complex collisions: true
-    FCollisionQueryParams TraceParams = FCollisionQueryParams(TEXT("2DLaser_Trace"), true, GetOwner());
-    TraceParams.bReturnPhysicalMaterial = true;
-    // TraceParams.bIgnoreTouches = true;
-    TraceParams.bTraceComplex = true;
-    TraceParams.bReturnFaceIndex = true;
-
-    FVector lidarPos = GetComponentLocation();
-    FRotator lidarRot = GetComponentRotation();
-
-    ParallelFor(
-        RecordedVizHits.Num(),
-        [this, &TraceParams, &lidarPos, &lidarRot, &RecordedVizHits](int32 Index)
-        {
-            const float HAngle = StartAngle + DHAngle * Index;
-
-            FRotator laserRot(0, HAngle, 0);
-            FRotator rot = UKismetMathLibrary::ComposeRotators(laserRot, lidarRot);
-
-            FVector startPos = lidarPos + MinRange * UKismetMathLibrary::GetForwardVector(rot);
-            FVector endPos = lidarPos + MaxRange * UKismetMathLibrary::GetForwardVector(rot);
-            // To be considered: + WithNoise * FVector(GaussianRNGPosition(Gen),GaussianRNGPosition(Gen),GaussianRNGPosition(Gen));
-
-            GetWorld()->LineTraceSingleByChannel(RecordedVizHits[Index],
-                                                 startPos,
-                                                 endPos,
-                                                 ECC_Visibility,
-                                                 TraceParams,
-                                                 FCollisionResponseParams::DefaultResponseParam);
-        },
-        false);
+    return (FMath::Abs(InLocalCenter.Z) <= InRadius) && Super::IsInScanFOV(InLocalCenter, InRadius);
+}
 
-    for (auto& h : RecordedVizHits)
+void URR2DLidarComponent::GetVisibilityProbes(const FBox& InTargetBounds, TArray<FVector, TInlineAllocator<9>>& OutProbes) const
+{
+    Super::GetVisibilityProbes(InTargetBounds, OutProbes);
+    const FTransform lidarTransform = GetComponentTransform();
+    for (auto& probe : OutProbes)
     {
-        if (h.GetActor() == TargetActor)
-        {
-            return true;
-        }
+        FVector localProbe = lidarTransform.InverseTransformPosition(probe);
+        localProbe.Z = 0.f;
+        probe = lidarTransform.TransformPosition(localProbe);
     }
-    return false;
 }
 
 float URR2DLidarComponent::GetMinAngleRadians() const
@@ -14,6 +14,8 @@ void URR3DLidarComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 #if TRACE_ASYNC
     verify(TraceHandles.Num() == RecordedHits.Num());
     UWorld* world = GetWorld();
+    bool bReceivedHits = false;
+    bool bScanCompleted = true;
     for (auto i = 0; i < TraceHandles.Num(); ++i)
     {
         FTraceHandle& traceHandle = TraceHandles[i];
@@ -23,6 +25,7 @@ void URR3DLidarComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
             FTraceDatum Output;
             if (world->QueryTraceData(traceHandle, Output))
             {
+                bReceivedHits = true;
                 if (Output.OutHits.Num() > 0)
                 {
                     traceHandle._Data.FrameNumber = 0;
@@ -37,8 +40,15 @@ void URR3DLidarComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
                     recordedHit.TraceEnd = Output.End;
                 }
             }
+            bScanCompleted &= (traceHandle._Data.FrameNumber == 0);
         }
     }
+
+    // Hit actors are only updated once the whole scan has completed, for #Visible
+    if (bReceivedHits && bScanCompleted)
+    {
+        UpdateScanHitActors();
+    }
 #endif
 }
 
@@ -120,6 +130,7 @@ void URR3DLidarComponent::SensorUpdate()
                 RecordedHits[Index], startPos, endPos, ECC_Visibility, TraceParams, FCollisionResponseParams::DefaultResponseParam);
         },
         false);
+    UpdateScanHitActors();
 #endif
 
     if (BWithNoise)
@@ -140,7 +151,7 @@ void URR3DLidarComponent::SensorUpdate()
     }
 
     TimeOfLastScan = UGameplayStatics::GetTimeSeconds(GetWorld());
-    Dt = 1.f / static_cast<float>(PublicationFrequencyHz);
+    Dt = (CurrentPublicationFrequencyHz > 0) ? (1.f / static_cast<float>(CurrentPublicationFrequencyHz)) : 0.f;
 
     // need to store on a structure associating hits with time?
     // GetROS2Data needs to get all data since the last Get? or the last within the last time interval?
@@ -221,56 +232,20 @@ void URR3DLidarComponent::SensorUpdate()
     }
 }
 
-bool URR3DLidarComponent::Visible(AActor* TargetActor)
+bool URR3DLidarComponent::IsInScanFOV(const FVector& InLocalCenter, const float InRadius) const
 {
-    TArray<FHitResult> RecordedVizHits;
-    RecordedVizHits.Init(FHitResult(ForceInit), GetTotalScan());
-
-    DHAngle = FOVHorizontal / static_cast<float>(NSamplesPerScan);
-    DVAngle = FOVVertical / static_cast<float>(NChannelsPerScan);
-
-    // complex collisions: true
-    FCollisionQueryParams TraceParams = FCollisionQueryParams(TEXT("3DLaser_Trace"), true, GetOwner());
-    TraceParams.bReturnPhysicalMaterial = true;
-    // TraceParams.bIgnoreTouches = true;
-    TraceParams.bTraceComplex = true;
-    TraceParams.bReturnFaceIndex = true;
-
-    FVector lidarPos = GetComponentLocation();
-    FRotator lidarRot = GetComponentRotation();
-
-    ParallelFor(
-        RecordedVizHits.Num(),
-        [this, &TraceParams, &lidarPos, &lidarRot, &RecordedVizHits](int32 Index)
-        {
-            const int IdxX = Index % NSamplesPerScan;
-            const int IdxY = Index / NSamplesPerScan;
-            const float HAngle = StartAngle + DHAngle * IdxX;
-            const float VAngle = StartVerticalAngle + DVAngle * IdxY;
-
-            FRotator laserRot(VAngle, HAngle, 0);
-            FRotator rot = UKismetMathLibrary::ComposeRotators(laserRot, lidarRot);
-
-            FVector startPos = lidarPos + MinRange * UKismetMathLibrary::GetForwardVector(rot);
-            FVector endPos = lidarPos + MaxRange * UKismetMathLibrary::GetForwardVector(rot);
-
-            GetWorld()->LineTraceSingleByChannel(RecordedVizHits[Index],
-                                                 startPos,
-                                                 endPos,
-                                                 ECC_Visibility,
-                                                 TraceParams,
-                                                 FCollisionResponseParams::DefaultResponseParam);
-        },
-        false);
-
-    for (auto& h : RecordedVizHits)
+    if (false == Super::IsInScanFOV(InLocalCenter, InRadius))
     {
-        if (h.GetActor() == TargetActor)
-        {
-            return true;
-        }
+        return false;
+    }
+    const float distance = InLocalCenter.Size();
+    if (distance <= InRadius)
+    {
+        return true;
     }
-    return false;
+    const float pitch = FMath::RadiansToDegrees(FMath::Atan2(InLocalCenter.Z, InLocalCenter.Size2D()));
+    const float halfHeight = FMath::RadiansToDegrees(FMath::Asin(InRadius / distance));
+    return ((pitch + halfHeight) >= StartVerticalAngle) && ((pitch - halfHeight) <= (StartVerticalAngle + FOVVertical));
 }
 
 FROSPointCloud2 URR3DLidarComponent::GetROS2Data()
@@ -2,6 +2,11 @@
 
 #include "Sensors/RRBaseLidarComponent.h"
 
+// UE
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+
 // RapyutaSimulationPlugins
 #include "Tools/RRROS2LidarPublisher.h"
 
@@ -26,6 +31,137 @@ void URRBaseLidarComponent::GetData(TArray<FHitResult>& OutHits, float& OutTime)
     OutTime = TimeOfLastScan;
 }
 
+bool URRBaseLidarComponent::Visible(AActor* TargetActor)
+{
+    TArray<bool> visibilities;
+    Visible(TArray<AActor*>({TargetActor}), visibilities);
+    return visibilities[0];
+}
+
+void URRBaseLidarComponent::Visible(const TArray<AActor*>& InTargetActors, TArray<bool>& OutVisibilities)
+{
+    OutVisibilities.Init(false, InTargetActors.Num());
+
+    const FTransform lidarTransform = GetComponentTransform();
+    const bool bIsScanFresh = (ScanHitActorsTime >= 0.f) &&
+                              (UGameplayStatics::GetTimeSeconds(GetWorld()) - ScanHitActorsTime <= MaxVisibilityScanAge);
+
+    TArray<int32> probedTargetIndices;
+    TArray<TArray<FVector, TInlineAllocator<9>>> probedTargetProbes;
+    for (int32 i = 0; i < InTargetActors.Num(); ++i)
+    {
+        AActor* targetActor = InTargetActors[i];
+        if (nullptr == targetActor)
+        {
+            continue;
+        }
+
+        // 1- Range & FOV rejection, by the target's bounding sphere
+        FVector boundsOrigin, boundsExtent;
+        targetActor->GetActorBounds(true, boundsOrigin, boundsExtent);
+        if (false == IsInScanFOV(lidarTransform.InverseTransformPosition(boundsOrigin), boundsExtent.Size()))
+        {
+            continue;
+        }
+
+        // 2- Hit actors of the last completed scan
+        if (bIsScanFresh)
+        {
+            OutVisibilities[i] = ScanHitActors.Contains(targetActor);
+            continue;
+        }
+
+        // 3- Probe rays, only those within scan FOV
+        auto& probes = probedTargetProbes.AddDefaulted_GetRef();
+        GetVisibilityProbes(FBox::BuildAABB(boundsOrigin, boundsExtent), probes);
+        probes.RemoveAll([this, &lidarTransform](const FVector& InProbe)
+                         { return (false == IsInScanFOV(lidarTransform.InverseTransformPosition(InProbe), 1.f)); });
+        probedTargetIndices.Add(i);
+    }
+
+    ParallelFor(probedTargetIndices.Num(),
+                [this, &InTargetActors, &OutVisibilities, &probedTargetIndices, &probedTargetProbes](int32 InIndex)
+                {
+                    const int32 targetIndex = probedTargetIndices[InIndex];
+                    OutVisibilities[targetIndex] = TraceVisibilityProbes(InTargetActors[targetIndex], probedTargetProbes[InIndex]);
+                });
+}
+
+void URRBaseLidarComponent::UpdateScanHitActors()
+{
+    ScanHitActors.Reset();
+    for (const auto& hit : RecordedHits)
+    {
+        if (AActor* hitActor = hit.GetActor())
+        {
+            ScanHitActors.Add(hitActor);
+        }
+    }
+    ScanHitActorsTime = UGameplayStatics::GetTimeSeconds(GetWorld());
+}
+
+bool URRBaseLidarComponent::IsInScanFOV(const FVector& InLocalCenter, const float InRadius) const
+{
+    const float distance = InLocalCenter.Size();
+    if ((distance - InRadius > MaxRange) || (distance + InRadius < MinRange))
+    {
+        return false;
+    }
+
+    const float horizontalDistance = InLocalCenter.Size2D();
+    if ((FOVHorizontal >= 360.f) || (horizontalDistance <= InRadius))
+    {
+        return true;
+    }
+    const float yaw = FMath::RadiansToDegrees(FMath::Atan2(InLocalCenter.Y, InLocalCenter.X));
+    const float halfWidth = FMath::RadiansToDegrees(FMath::Asin(InRadius / horizontalDistance));
+    const float halfFOV = 0.5f * FOVHorizontal;
+    return FMath::Abs(FRotator::NormalizeAxis(yaw - StartAngle - halfFOV)) <= (halfFOV + halfWidth);
+}
+
+void URRBaseLidarComponent::GetVisibilityProbes(const FBox& InTargetBounds, TArray<FVector, TInlineAllocator<9>>& OutProbes) const
+{
+    // Bounds center & corners of its half-size box, so that probes are likely to land on the target's surface
+    const FVector center = InTargetBounds.GetCenter();
+    const FVector halfExtent = 0.5f * InTargetBounds.GetExtent();
+    OutProbes.Add(center);
+    if (false == halfExtent.IsNearlyZero())
+    {
+        for (int32 i = 0; i < 8; ++i)
+        {
+            OutProbes.Add(center + halfExtent * FVector((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : -1.f));
+        }
+    }
+}
+
+bool URRBaseLidarComponent::TraceVisibilityProbes(const AActor* InTargetActor,
+                                                  const TArray<FVector, TInlineAllocator<9>>& InProbes) const
+{
+    FCollisionQueryParams traceParams = FCollisionQueryParams(TEXT("LidarVisibility_Trace"), true, GetOwner());
+    const FVector lidarPos = GetComponentLocation();
+    UWorld* world = GetWorld();
+    for (const FVector& probe : InProbes)
+    {
+        const FVector direction = (probe - lidarPos).GetSafeNormal();
+        if (direction.IsZero())
+        {
+            continue;
+        }
+        FHitResult hit;
+        if (world->LineTraceSingleByChannel(hit,
+                                            lidarPos + MinRange * direction,
+                                            lidarPos + MaxRange * direction,
+                                            ECC_Visibility,
+                                            traceParams,
+                                            FCollisionResponseParams::DefaultResponseParam) &&
+            (hit.GetActor() == InTargetActor))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 FLinearColor URRBaseLidarComponent::InterpColorFromIntensity(const float InIntensity)
 {
     return InterpolateColor(FMath::GetRangePct(IntensityMin, IntensityMax, InIntensity));
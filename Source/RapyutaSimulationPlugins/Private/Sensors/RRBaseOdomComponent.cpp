@@ -2,6 +2,8 @@
 
 #include "Sensors/RRBaseOdomComponent.h"
 
+#include <sstream>
+
 URRBaseOdomComponent::URRBaseOdomComponent()
 {
     SensorPublisherClass = URRROS2OdomPublisher::StaticClass();
@@ -129,6 +131,35 @@ void URRBaseOdomComponent::UpdateOdom(float InDeltaTime)
     OdomData.Pose.Pose.Orientation *= RootOffset.GetRotation();
 }
 
+void URRBaseOdomComponent::SerializeOdomState(FArchive& InOutAr, const bool bInRestoreTime)
+{
+    InOutAr << bIsOdomInitialized << LastUpdatedTime << OdomData.Header.Stamp.Sec << OdomData.Header.Stamp.Nanosec;
+    InOutAr << InitialTransform << PreviousTransform << PreviousNoisyTransform;
+    InOutAr << OdomData.Pose.Pose.Position << OdomData.Pose.Pose.Orientation;
+    InOutAr << OdomData.Twist.Twist.Linear << OdomData.Twist.Twist.Angular;
+
+    // Noise RNG state, incl distributions' cached samples, in std text format
+    std::stringstream rngStream;
+    FString rngState;
+    if (InOutAr.IsSaving())
+    {
+        rngStream << Gen << ' ' << GaussianRNGPosition << ' ' << GaussianRNGRotation;
+        rngState = UTF8_TO_TCHAR(rngStream.str().c_str());
+    }
+    InOutAr << rngState;
+
+    if (InOutAr.IsLoading())
+    {
+        rngStream.str(TCHAR_TO_UTF8(*rngState));
+        rngStream >> Gen >> GaussianRNGPosition >> GaussianRNGRotation;
+        if (false == bInRestoreTime)
+        {
+            LastUpdatedTime = UGameplayStatics::GetTimeSeconds(GetWorld());
+            OdomData.Header.Stamp = URRConversionUtils::FloatToROSStamp(LastUpdatedTime);
+        }
+    }
+}
+
 FTransform URRBaseOdomComponent::GetOdomTF() const
 {
     return FTransform(OdomData.Pose.Pose.Orientation, OdomData.Pose.Pose.Position);
@@ -2,6 +2,9 @@
 
 #include "Sensors/RRROS2BaseSensorComponent.h"
 
+// RapyutaSimulationPlugins
+#include "Sensors/RRSensorBudgetManager.h"
+
 DEFINE_LOG_CATEGORY(LogROS2Sensor);
 
 URRROS2BaseSensorComponent::URRROS2BaseSensorComponent()
@@ -65,11 +68,57 @@ void URRROS2BaseSensorComponent::InitializePublisher(UROS2NodeComponent* InROS2N
 
 void URRROS2BaseSensorComponent::Run()
 {
-    GetWorld()->GetTimerManager().SetTimer(
-        TimerHandle, this, &URRROS2BaseSensorComponent::SensorUpdate, 1.f / static_cast<float>(PublicationFrequencyHz), true);
+    CurrentPublicationFrequencyHz = PublicationFrequencyHz;
+    GetWorld()->GetTimerManager().SetTimer(TimerHandle,
+                                           this,
+                                           &URRROS2BaseSensorComponent::TimedSensorUpdate,
+                                           1.f / static_cast<float>(CurrentPublicationFrequencyHz),
+                                           true);
+
+    URRSensorBudgetManager* budgetManager = GetWorld()->GetSubsystem<URRSensorBudgetManager>();
+    if (budgetManager)
+    {
+        budgetManager->RegisterSensor(this);
+    }
 }
 
 void URRROS2BaseSensorComponent::Stop()
 {
     GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+
+    URRSensorBudgetManager* budgetManager = GetWorld()->GetSubsystem<URRSensorBudgetManager>();
+    if (budgetManager)
+    {
+        budgetManager->UnregisterSensor(this);
+    }
+}
+
+void URRROS2BaseSensorComponent::SetCurrentPublicationFrequencyHz(const int32 InFrequencyHz)
+{
+    const int32 minFrequencyHz = FMath::Max(1, FMath::Min(MinPublicationFrequencyHz, PublicationFrequencyHz));
+    const int32 frequencyHz = FMath::Clamp(InFrequencyHz, minFrequencyHz, PublicationFrequencyHz);
+    if ((frequencyHz == CurrentPublicationFrequencyHz) || (false == TimerHandle.IsValid()))
+    {
+        return;
+    }
+    CurrentPublicationFrequencyHz = frequencyHz;
+
+    // Re-arm the sensor timer only, keeping sensor data as is
+    GetWorld()->GetTimerManager().SetTimer(
+        TimerHandle, this, &URRROS2BaseSensorComponent::TimedSensorUpdate, 1.f / static_cast<float>(frequencyHz), true);
+
+    // Loop publisher, if any, follows
+    if (IsValid(SensorPublisher) && (SensorPublisher->PublicationFrequencyHz > 0))
+    {
+        SensorPublisher->PublicationFrequencyHz = frequencyHz;
+        SensorPublisher->StopPublishTimer();
+        SensorPublisher->StartPublishTimer();
+    }
+}
+
+void URRROS2BaseSensorComponent::TimedSensorUpdate()
+{
+    const double startTime = FPlatformTime::Seconds();
+    SensorUpdate();
+    UpdateCost += FPlatformTime::Seconds() - startTime;
 }
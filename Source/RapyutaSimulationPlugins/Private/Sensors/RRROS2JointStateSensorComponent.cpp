@@ -0,0 +1,131 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Sensors/RRROS2JointStateSensorComponent.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRConversionUtils.h"
+#include "Robots/RRBaseRobot.h"
+#include "Robots/RRRobotROS2Interface.h"
+
+URRROS2JointStateSensorComponent::URRROS2JointStateSensorComponent()
+{
+    SensorPublisherClass = URRROS2JointStatePublisher::StaticClass();
+    TopicName = TEXT("joint_states");
+}
+
+void URRROS2JointStateSensorComponent::PreInitializePublisher(UROS2NodeComponent* InROS2Node, const FString& InTopicName)
+{
+    InitJointBuffer();
+    Super::PreInitializePublisher(InROS2Node, InTopicName);
+
+    // After Super::, which may prepend the node namespace to FrameId
+    Data.Header.FrameId = FrameId;
+
+    const auto* robot = Cast<ARRBaseRobot>(GetOwner());
+    if (robot && robot->ROS2Interface && IsValid(SensorPublisher) &&
+        (SensorPublisher->TopicName == robot->ROS2Interface->JointsCmdTopicName))
+    {
+        UE_LOG_WITH_INFO_NAMED(LogROS2Sensor,
+                               Warning,
+                               TEXT("[%s] publishes joint states to [%s], which is also subscribed as joint commands by %s"),
+                               *GetName(),
+                               *SensorPublisher->TopicName,
+                               *robot->ROS2Interface->GetName());
+    }
+}
+
+bool URRROS2JointStateSensorComponent::InitJointBuffer()
+{
+    JointComponents.Reset();
+    Data.Name.Reset();
+
+    const auto* robot = Cast<ARRBaseRobot>(GetOwner());
+    if (nullptr == robot)
+    {
+        UE_LOG_WITH_INFO_NAMED(LogROS2Sensor, Warning, TEXT("[%s] Owner is not ARRBaseRobot"), *GetName());
+        return false;
+    }
+
+    // Fixed publishing order: given JointNames or else the robot's joints order
+    if (JointNames.Num() > 0)
+    {
+        JointComponents.Reserve(JointNames.Num());
+        Data.Name.Reserve(JointNames.Num());
+        for (const auto& jointName : JointNames)
+        {
+            URRJointComponent* joint = robot->Joints.FindRef(jointName);
+            if (nullptr == joint)
+            {
+                UE_LOG_WITH_INFO_NAMED(
+                    LogROS2Sensor, Warning, TEXT("[%s] %s does not have joint named %s"), *GetName(), *robot->GetName(), *jointName);
+                continue;
+            }
+            JointComponents.Add(joint);
+            Data.Name.Add(jointName);
+        }
+    }
+    else
+    {
+        JointComponents.Reserve(robot->Joints.Num());
+        Data.Name.Reserve(robot->Joints.Num());
+        for (const auto& joint : robot->Joints)
+        {
+            if (joint.Value)
+            {
+                JointComponents.Add(joint.Value);
+                Data.Name.Add(joint.Key);
+            }
+        }
+    }
+
+    const int32 jointsNum = JointComponents.Num();
+    Data.Position.SetNumZeroed(jointsNum);
+    Data.Velocity.SetNumZeroed(jointsNum);
+    Data.Effort.SetNumZeroed(jointsNum);
+
+    return (jointsNum > 0);
+}
+
+void URRROS2JointStateSensorComponent::SensorUpdate()
+{
+    // Joints of dynamically created robots could be only available after publisher initialization
+    if ((0 == JointComponents.Num()) && (false == InitJointBuffer()))
+    {
+        bIsValid = false;
+        return;
+    }
+
+    Data.Header.Stamp = URRConversionUtils::FloatToROSStamp(UGameplayStatics::GetTimeSeconds(GetWorld()));
+    for (int32 i = 0; i < JointComponents.Num(); ++i)
+    {
+        const URRJointComponent* joint = JointComponents[i];
+        if (nullptr == joint)
+        {
+            continue;
+        }
+
+        // UE To ROS conversion
+        if (joint->LinearDOF == 1)
+        {
+            Data.Position[i] = URRConversionUtils::DistanceUEToROS(joint->Position.X);
+            Data.Velocity[i] = URRConversionUtils::DistanceUEToROS(joint->LinearVelocity.X);
+        }
+        else if (joint->RotationalDOF == 1)
+        {
+            Data.Position[i] = FMath::DegreesToRadians(joint->Orientation.Euler().X);
+            Data.Velocity[i] = FMath::DegreesToRadians(joint->AngularVelocity.X);
+        }
+    }
+
+    bIsValid = true;
+}
+
+FROSJointState URRROS2JointStateSensorComponent::GetROS2Data()
+{
+    return Data;
+}
+
+void URRROS2JointStateSensorComponent::SetROS2Msg(UROS2GenericMsg* InMessage)
+{
+    CastChecked<UROS2JointStateMsg>(InMessage)->SetMsg(Data);
+}
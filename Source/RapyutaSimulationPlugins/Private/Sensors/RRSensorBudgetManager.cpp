@@ -0,0 +1,238 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Sensors/RRSensorBudgetManager.h"
+
+// UE
+#include "Engine/Engine.h"
+#include "Misc/App.h"
+
+// rclUE
+#include "Msgs/ROS2Str.h"
+#include "ROS2NodeComponent.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRActorCommon.h"
+#include "Sensors/RRROS2BaseSensorComponent.h"
+#include "Tools/RRLimitRTFFixedSizeCustomTimeStep.h"
+#include "Tools/RRROS2StringPublisher.h"
+
+void URRSensorBudgetManager::RegisterSensor(URRROS2BaseSensorComponent* InSensor)
+{
+    if ((nullptr == InSensor) || Sensors.Contains(InSensor))
+    {
+        return;
+    }
+    Sensors.Add(InSensor);
+    SensorCosts.Add(0.f);
+}
+
+void URRSensorBudgetManager::UnregisterSensor(URRROS2BaseSensorComponent* InSensor)
+{
+    const int32 sensorIndex = Sensors.IndexOfByKey(InSensor);
+    if (INDEX_NONE != sensorIndex)
+    {
+        Sensors.RemoveAtSwap(sensorIndex);
+        SensorCosts.RemoveAtSwap(sensorIndex);
+    }
+}
+
+void URRSensorBudgetManager::InitDiagnosticsPublisher(UROS2NodeComponent* InROS2Node)
+{
+    if ((nullptr == InROS2Node) || IsValid(DiagnosticsPublisher))
+    {
+        return;
+    }
+
+    // Event-driven, only publishing upon adjustments
+    DiagnosticsPublisher = NewObject<URRROS2StringPublisher>(this, TEXT("SensorBudgetDiagnosticsPublisher"));
+    DiagnosticsPublisher->TopicName = DiagnosticsTopicName;
+    DiagnosticsPublisher->PublicationFrequencyHz = -1;
+    DiagnosticsPublisher->QoS = UROS2QoS::KeepLast;
+    DiagnosticsPublisher->InitializeWithROS2(InROS2Node);
+    DiagnosticsPublisher->Init();
+}
+
+float URRSensorBudgetManager::GetFrameBudget(float InDeltaTime) const
+{
+    float targetRTF = DefaultTargetRTF;
+    auto* customTimeStep = Cast<URRLimitRTFFixedSizeCustomTimeStep>(GEngine->GetCustomTimeStep());
+    if (customTimeStep)
+    {
+        InDeltaTime = customTimeStep->GetStepSize();
+        targetRTF = customTimeStep->GetTargetRTF();
+    }
+    return (targetRTF > 0.f) ? (InDeltaTime / targetRTF) : 0.f;
+}
+
+float URRSensorBudgetManager::GetOwnerCost(const AActor* InOwner) const
+{
+    float ownerCost = 0.f;
+    for (int32 i = 0; i < Sensors.Num(); ++i)
+    {
+        if (Sensors[i].IsValid() && (InOwner == Sensors[i]->GetOwner()))
+        {
+            ownerCost += SensorCosts[i];
+        }
+    }
+    return ownerCost;
+}
+
+void URRSensorBudgetManager::Tick(float InDeltaTime)
+{
+    const double currentTime = FPlatformTime::Seconds();
+    const double frameTime = (LastTickTime > 0.0) ? (currentTime - LastTickTime) : 0.0;
+    LastTickTime = currentTime;
+    if ((false == bEnabled) || (frameTime <= 0.0))
+    {
+        return;
+    }
+
+    // 1- Measure, excluding RTF-limiting waits which are reported as idle time
+    const float workTime = static_cast<float>(FMath::Max(frameTime - FApp::GetIdleTime(), 0.0));
+    SmoothedWorkTime = FMath::Lerp(SmoothedWorkTime, workTime, SmoothingFactor);
+    for (int32 i = Sensors.Num() - 1; i >= 0; --i)
+    {
+        if (Sensors[i].IsValid())
+        {
+            SensorCosts[i] = FMath::Lerp(SensorCosts[i], static_cast<float>(Sensors[i]->ConsumeUpdateCost()), SmoothingFactor);
+        }
+        else
+        {
+            Sensors.RemoveAtSwap(i);
+            SensorCosts.RemoveAtSwap(i);
+        }
+    }
+
+    // 2- Control, with hysteresis between [RestoreRatio] & [ThrottleRatio]
+    LastFrameBudget = GetFrameBudget(InDeltaTime);
+    if (LastFrameBudget <= 0.f)
+    {
+        return;
+    }
+    if (SmoothedWorkTime >= RestoreRatio * LastFrameBudget)
+    {
+        HeadroomStartTime = currentTime;
+    }
+    if ((currentTime - LastAdjustmentTime) < AdjustmentIntervalSeconds)
+    {
+        return;
+    }
+
+    if (SmoothedWorkTime > ThrottleRatio * LastFrameBudget)
+    {
+        if (ThrottleSensor())
+        {
+            LastThrottleTime = currentTime;
+            LastAdjustmentTime = currentTime;
+        }
+    }
+    else if (((currentTime - HeadroomStartTime) >= RestoreHoldSeconds) && ((currentTime - LastThrottleTime) >= RestoreHoldSeconds))
+    {
+        if (RestoreSensor())
+        {
+            LastAdjustmentTime = currentTime;
+        }
+    }
+}
+
+bool URRSensorBudgetManager::ThrottleSensor()
+{
+    int32 selectedIndex = INDEX_NONE;
+    for (int32 i = 0; i < Sensors.Num(); ++i)
+    {
+        const URRROS2BaseSensorComponent* sensor = Sensors[i].Get();
+        if ((false == sensor->bDegradable) ||
+            (sensor->CurrentPublicationFrequencyHz <= FMath::Max(1, sensor->MinPublicationFrequencyHz)))
+        {
+            continue;
+        }
+        if (INDEX_NONE == selectedIndex)
+        {
+            selectedIndex = i;
+            continue;
+        }
+
+        // Lowest priority first, then costliest
+        const URRROS2BaseSensorComponent* selected = Sensors[selectedIndex].Get();
+        if ((sensor->BudgetPriority < selected->BudgetPriority) ||
+            ((sensor->BudgetPriority == selected->BudgetPriority) && (SensorCosts[i] > SensorCosts[selectedIndex])))
+        {
+            selectedIndex = i;
+        }
+    }
+    if (INDEX_NONE == selectedIndex)
+    {
+        return false;
+    }
+
+    const int32 currentHz = Sensors[selectedIndex]->CurrentPublicationFrequencyHz;
+    AdjustSensor(selectedIndex, FMath::Min(FMath::FloorToInt32(currentHz * ThrottleFactor), currentHz - 1), TEXT("throttle"));
+    return true;
+}
+
+bool URRSensorBudgetManager::RestoreSensor()
+{
+    int32 selectedIndex = INDEX_NONE;
+    for (int32 i = 0; i < Sensors.Num(); ++i)
+    {
+        const URRROS2BaseSensorComponent* sensor = Sensors[i].Get();
+        if ((false == sensor->bDegradable) || (sensor->CurrentPublicationFrequencyHz >= sensor->PublicationFrequencyHz))
+        {
+            continue;
+        }
+        if (INDEX_NONE == selectedIndex)
+        {
+            selectedIndex = i;
+            continue;
+        }
+
+        // Highest priority first, then cheapest
+        const URRROS2BaseSensorComponent* selected = Sensors[selectedIndex].Get();
+        if ((sensor->BudgetPriority > selected->BudgetPriority) ||
+            ((sensor->BudgetPriority == selected->BudgetPriority) && (SensorCosts[i] < SensorCosts[selectedIndex])))
+        {
+            selectedIndex = i;
+        }
+    }
+    if (INDEX_NONE == selectedIndex)
+    {
+        return false;
+    }
+
+    const int32 currentHz = Sensors[selectedIndex]->CurrentPublicationFrequencyHz;
+    const float factor = (ThrottleFactor > 0.f) ? (1.f / ThrottleFactor) : 2.f;
+    AdjustSensor(selectedIndex, FMath::Max(FMath::CeilToInt32(currentHz * factor), currentHz + 1), TEXT("restore"));
+    return true;
+}
+
+void URRSensorBudgetManager::AdjustSensor(const int32 InSensorIndex, const int32 InFrequencyHz, const TCHAR* InReason)
+{
+    URRROS2BaseSensorComponent* sensor = Sensors[InSensorIndex].Get();
+    const int32 prevFrequencyHz = sensor->CurrentPublicationFrequencyHz;
+    sensor->SetCurrentPublicationFrequencyHz(InFrequencyHz);
+
+    AActor* owner = sensor->GetOwner();
+    const FString report = FString::Printf(
+        TEXT("%s sensor=%s robot=%s priority=%d rate_hz=%d->%d min_hz=%d nominal_hz=%d sensor_cost_ms=%.3f robot_cost_ms=%.3f ")
+            TEXT("work_ms=%.3f budget_ms=%.3f"),
+        InReason,
+        *sensor->GetName(),
+        owner ? *owner->GetName() : TEXT("none"),
+        static_cast<int32>(sensor->BudgetPriority),
+        prevFrequencyHz,
+        sensor->CurrentPublicationFrequencyHz,
+        sensor->MinPublicationFrequencyHz,
+        sensor->PublicationFrequencyHz,
+        SensorCosts[InSensorIndex] * 1000.f,
+        GetOwnerCost(owner) * 1000.f,
+        SmoothedWorkTime * 1000.f,
+        LastFrameBudget * 1000.f);
+    UE_LOG_WITH_INFO(LogRapyutaCore, Log, TEXT("%s"), *report);
+
+    if (IsValid(DiagnosticsPublisher))
+    {
+        FROSStr msg;
+        msg.Data = report;
+        DiagnosticsPublisher->Publish<UROS2StrMsg, FROSStr>(msg);
+    }
+}
@@ -0,0 +1,394 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Tools/RRCommandRecorder.h"
+
+// UE
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+// rclUE
+#include "Srvs/ROS2Attach.h"
+#include "Srvs/ROS2DeleteEntity.h"
+#include "Srvs/ROS2SetEntityState.h"
+#include "Srvs/ROS2SpawnEntity.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRActorCommon.h"
+#include "Core/RRUObjectUtils.h"
+#include "Robots/RRBaseRobot.h"
+#include "Tools/SimulationState.h"
+
+template<typename TRequest>
+static void ReadSimStateRequest(FArchive& InOutAr, int32& OutNetworkPlayerId, TRequest& OutRequest)
+{
+    InOutAr << OutNetworkPlayerId;
+    TRequest::StaticStruct()->SerializeItem(InOutAr, &OutRequest, nullptr);
+}
+
+void URRCommandRecorder::Initialize(FSubsystemCollectionBase& InCollection)
+{
+    Super::Initialize(InCollection);
+    WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &URRCommandRecorder::OnWorldTickStart);
+
+    // Command line overrides config
+    FString logFilePath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("RRCommandRecord="), logFilePath))
+    {
+        Mode = ERRCommandRecorderMode::RECORD;
+        LogFilePath = logFilePath;
+    }
+    else if (FParse::Value(FCommandLine::Get(), TEXT("RRCommandReplay="), logFilePath))
+    {
+        Mode = ERRCommandRecorderMode::REPLAY;
+        LogFilePath = logFilePath;
+    }
+    bExitOnReplayEnd |= FParse::Param(FCommandLine::Get(), TEXT("RRCommandReplayExit"));
+
+    LogData.Reset();
+    uint32 magic = MAGIC;
+    uint32 version = VERSION;
+    if (IsRecording())
+    {
+        FMemoryWriter writer(LogData, true);
+        writer << magic << version;
+        UE_LOG_WITH_INFO(LogRapyutaCore, Display, TEXT("Recording inbound commands to [%s]"), *GetFullLogFilePath());
+    }
+    else if (IsReplaying())
+    {
+        if (false == FFileHelper::LoadFileToArray(LogData, *GetFullLogFilePath()))
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed to load command log [%s]"), *GetFullLogFilePath());
+            Mode = ERRCommandRecorderMode::NONE;
+            return;
+        }
+
+        FMemoryReader reader(LogData, true);
+        reader << magic << version;
+        if (reader.IsError() || (MAGIC != magic) || (VERSION != version))
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore,
+                             Error,
+                             TEXT("Invalid command log [%s], of version [%u] vs [%u]"),
+                             *GetFullLogFilePath(),
+                             version,
+                             VERSION);
+            Mode = ERRCommandRecorderMode::NONE;
+            return;
+        }
+        ReplayOffset = reader.Tell();
+        UE_LOG_WITH_INFO(LogRapyutaCore, Display, TEXT("Replaying inbound commands from [%s]"), *GetFullLogFilePath());
+    }
+}
+
+void URRCommandRecorder::Deinitialize()
+{
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+    if (IsRecording())
+    {
+        SaveLog();
+    }
+    Super::Deinitialize();
+}
+
+void URRCommandRecorder::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+    TickCount = 0;
+    TickStartTime = InWorld.GetTimeSeconds();
+    bHasBegunPlay = true;
+    if (IsReplaying())
+    {
+        ReplayCommands(TickCount);
+    }
+}
+
+FString URRCommandRecorder::GetFullLogFilePath() const
+{
+    return FPaths::IsRelative(LogFilePath) ? (FPaths::ProjectSavedDir() / LogFilePath) : LogFilePath;
+}
+
+bool URRCommandRecorder::SaveLog() const
+{
+    if (false == FFileHelper::SaveArrayToFile(LogData, *GetFullLogFilePath()))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Failed to write command log [%s]"), *GetFullLogFilePath());
+        return false;
+    }
+    UE_LOG_WITH_INFO(
+        LogRapyutaCore, Display, TEXT("Command log written to [%s], %d bytes"), *GetFullLogFilePath(), LogData.Num());
+    return true;
+}
+
+void URRCommandRecorder::RecordCommand(const ERRRecordedCommandType InType, TFunctionRef<void(FArchive&)> InSerializePayload)
+{
+    if (false == IsRecording())
+    {
+        return;
+    }
+
+    FMemoryWriter memWriter(LogData, true, true);
+    FObjectAndNameAsStringProxyArchive writer(memWriter, false);
+    int64 tick = TickCount;
+    double simTime = TickStartTime;
+    uint8 type = static_cast<uint8>(InType);
+    int32 payloadSize = 0;
+    writer << tick << simTime << type;
+
+    // Payload, prefixed by its size which is patched after serializing it
+    const int64 payloadSizeOffset = writer.Tell();
+    writer << payloadSize;
+    InSerializePayload(writer);
+    const int64 payloadEnd = writer.Tell();
+    payloadSize = static_cast<int32>(payloadEnd - payloadSizeOffset - sizeof(int32));
+    writer.Seek(payloadSizeOffset);
+    writer << payloadSize;
+    writer.Seek(payloadEnd);
+}
+
+void URRCommandRecorder::RecordCmdVel(const ARRBaseRobot* InRobot, const FVector& InLinearVel, const FVector& InAngularVel)
+{
+    if ((false == IsRecording()) || (nullptr == InRobot))
+    {
+        return;
+    }
+
+    FString robotName = InRobot->GetName();
+    FVector linearVel = InLinearVel;
+    FVector angularVel = InAngularVel;
+    RecordCommand(ERRRecordedCommandType::CMD_VEL, [&](FArchive& InOutAr) { InOutAr << robotName << linearVel << angularVel; });
+}
+
+void URRCommandRecorder::RecordJointState(const ARRBaseRobot* InRobot,
+                                          const TMap<FString, TArray<float>>& InJointState,
+                                          const ERRJointControlType InJointControlType)
+{
+    if ((false == IsRecording()) || (nullptr == InRobot))
+    {
+        return;
+    }
+
+    FString robotName = InRobot->GetName();
+    TMap<FString, TArray<float>> jointState = InJointState;
+    uint8 jointControlType = static_cast<uint8>(InJointControlType);
+    RecordCommand(ERRRecordedCommandType::JOINT_STATE,
+                  [&](FArchive& InOutAr) { InOutAr << robotName << jointState << jointControlType; });
+}
+
+void URRCommandRecorder::RecordSimStateRequest(const ERRRecordedCommandType InType,
+                                               UScriptStruct* InRequestStruct,
+                                               const void* InRequest,
+                                               const int32 InNetworkPlayerId)
+{
+    if (false == IsRecording())
+    {
+        return;
+    }
+
+    int32 networkPlayerId = InNetworkPlayerId;
+    RecordCommand(InType,
+                  [&](FArchive& InOutAr)
+                  {
+                      InOutAr << networkPlayerId;
+                      InRequestStruct->SerializeItem(InOutAr, const_cast<void*>(InRequest), nullptr);
+                  });
+}
+
+void URRCommandRecorder::RecordWorldCheckpoint(const bool bInSave)
+{
+    bool bSave = bInSave;
+    RecordCommand(ERRRecordedCommandType::WORLD_CHECKPOINT, [&](FArchive& InOutAr) { InOutAr << bSave; });
+}
+
+void URRCommandRecorder::OnWorldTickStart(UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds)
+{
+    if ((GetWorld() != InWorld) || (false == bHasBegunPlay))
+    {
+        return;
+    }
+
+    // Commands recorded during the N-th tick, whether from game thread tasks run before it or from actor ticks, are replayed
+    // at its start, ie before all of them
+    TickCount++;
+    TickStartTime = InWorld->GetTimeSeconds();
+    if (IsReplaying() && (false == bReplayFinished))
+    {
+        ReplayCommands(TickCount);
+    }
+}
+
+void URRCommandRecorder::ReplayCommands(const int64 InTick)
+{
+    FMemoryReader memReader(LogData, true);
+    memReader.Seek(ReplayOffset);
+    FObjectAndNameAsStringProxyArchive reader(memReader, true);
+
+    while (false == memReader.AtEnd())
+    {
+        const int64 commandOffset = memReader.Tell();
+        int64 tick = 0;
+        double simTime = 0.0;
+        uint8 type = 0;
+        int32 payloadSize = 0;
+        reader << tick;
+        if (tick > InTick)
+        {
+            memReader.Seek(commandOffset);
+            break;
+        }
+        reader << simTime << type << payloadSize;
+        const int64 payloadEnd = memReader.Tell() + payloadSize;
+        if (reader.IsError() || (payloadSize < 0) || (payloadEnd > LogData.Num()))
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Corrupted command log at offset [%lld] -> replay aborted"), commandOffset);
+            memReader.Seek(LogData.Num());
+            break;
+        }
+
+        if ((false == bWarnedTimeDrift) && (FMath::Abs(simTime - TickStartTime) > UE_KINDA_SMALL_NUMBER))
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore,
+                             Warning,
+                             TEXT("Sim time drifts from command log, [%f] vs recorded [%f] at tick [%lld]. Is fixed time step used?"),
+                             TickStartTime,
+                             simTime,
+                             tick);
+            bWarnedTimeDrift = true;
+        }
+
+        if (false == ApplyCommand(static_cast<ERRRecordedCommandType>(type), reader))
+        {
+            UE_LOG_WITH_INFO(
+                LogRapyutaCore, Warning, TEXT("Command of type [%u] at tick [%lld] could not be replayed"), type, tick);
+        }
+        memReader.Seek(payloadEnd);
+    }
+
+    ReplayOffset = memReader.Tell();
+    if (memReader.AtEnd())
+    {
+        bReplayFinished = true;
+        UE_LOG_WITH_INFO(LogRapyutaCore, Display, TEXT("Command log fully replayed at tick [%lld]"), InTick);
+        if (bExitOnReplayEnd)
+        {
+            FPlatformMisc::RequestExit(false);
+        }
+    }
+}
+
+bool URRCommandRecorder::ApplyCommand(const ERRRecordedCommandType InType, FArchive& InOutAr)
+{
+    switch (InType)
+    {
+        case ERRRecordedCommandType::CMD_VEL:
+        {
+            FString robotName;
+            FVector linearVel = FVector::ZeroVector;
+            FVector angularVel = FVector::ZeroVector;
+            InOutAr << robotName << linearVel << angularVel;
+            ARRBaseRobot* robot = FindRobot(robotName);
+            if (nullptr == robot)
+            {
+                return false;
+            }
+            robot->SetLinearVel(linearVel);
+            robot->SetAngularVel(angularVel);
+            return true;
+        }
+
+        case ERRRecordedCommandType::JOINT_STATE:
+        {
+            FString robotName;
+            TMap<FString, TArray<float>> jointState;
+            uint8 jointControlType = 0;
+            InOutAr << robotName << jointState << jointControlType;
+            ARRBaseRobot* robot = FindRobot(robotName);
+            if (nullptr == robot)
+            {
+                return false;
+            }
+            robot->SetJointState(jointState, static_cast<ERRJointControlType>(jointControlType));
+            return true;
+        }
+
+        default:
+            break;
+    }
+
+    // Sim state operations
+    ASimulationState* simState = FindSimState();
+    if (nullptr == simState)
+    {
+        return false;
+    }
+    int32 networkPlayerId = 0;
+    switch (InType)
+    {
+        case ERRRecordedCommandType::SET_ENTITY_STATE:
+        {
+            FROSSetEntityStateReq request;
+            ReadSimStateRequest(InOutAr, networkPlayerId, request);
+            simState->ServerSetEntityState(request);
+            return true;
+        }
+
+        case ERRRecordedCommandType::ATTACH:
+        {
+            FROSAttachReq request;
+            ReadSimStateRequest(InOutAr, networkPlayerId, request);
+            simState->ServerAttach(request);
+            return true;
+        }
+
+        case ERRRecordedCommandType::SPAWN_ENTITY:
+        {
+            FROSSpawnEntityReq request;
+            ReadSimStateRequest(InOutAr, networkPlayerId, request);
+            return (nullptr != simState->ServerSpawnEntity(request, networkPlayerId));
+        }
+
+        case ERRRecordedCommandType::DELETE_ENTITY:
+        {
+            FROSDeleteEntityReq request;
+            ReadSimStateRequest(InOutAr, networkPlayerId, request);
+            simState->ServerDeleteEntity(request);
+            return true;
+        }
+
+        case ERRRecordedCommandType::WORLD_CHECKPOINT:
+        {
+            bool bSave = false;
+            InOutAr << bSave;
+            return bSave ? simState->ServerSaveCheckpoint() : (INDEX_NONE != simState->ServerRestoreCheckpoint());
+        }
+
+        default:
+            return false;
+    }
+}
+
+ARRBaseRobot* URRCommandRecorder::FindRobot(const FString& InRobotName)
+{
+    TWeakObjectPtr<ARRBaseRobot>& robot = RobotCache.FindOrAdd(InRobotName);
+    if (false == robot.IsValid())
+    {
+        robot = URRUObjectUtils::FindActorByName<ARRBaseRobot>(GetWorld(), InRobotName, ESearchCase::CaseSensitive);
+    }
+    return robot.Get();
+}
+
+ASimulationState* URRCommandRecorder::FindSimState()
+{
+    if (false == SimState.IsValid())
+    {
+        TActorIterator<ASimulationState> simStateItr(GetWorld());
+        SimState = simStateItr ? *simStateItr : nullptr;
+    }
+    return SimState.Get();
+}
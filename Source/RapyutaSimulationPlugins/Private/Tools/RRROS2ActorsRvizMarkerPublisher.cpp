@@ -12,25 +12,144 @@ URRROS2ActorsRvizMarkerPublisher::URRROS2ActorsRvizMarkerPublisher()
     SetDefaultDelegates();    //use UpdateMessage as update delegate
 }
 
+void URRROS2ActorsRvizMarkerPublisher::BeginDestroy()
+{
+    if (ActorSpawnedWorld.IsValid() && ActorSpawnedHandle.IsValid())
+    {
+        ActorSpawnedWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        ActorSpawnedHandle.Reset();
+    }
+    Super::BeginDestroy();
+}
+
+void URRROS2ActorsRvizMarkerPublisher::InitActorsList()
+{
+    UWorld* world = GetWorld();
+    if (nullptr == world)
+    {
+        return;
+    }
+
+    UGameplayStatics::GetAllActorsOfClass(world, ActorClass, Actors);
+    RefreshMarkers();
+
+    ActorSpawnedHandle = world->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &URRROS2ActorsRvizMarkerPublisher::OnActorSpawned));
+    ActorSpawnedWorld = world;
+}
+
+void URRROS2ActorsRvizMarkerPublisher::RefreshMarkers()
+{
+    TArray<AActor*> actors = MoveTemp(Actors);
+    Actors.Reset(actors.Num());
+    MarkersMsg.Markers.Reset(actors.Num());
+    LastPublishedTransforms.Reset(actors.Num());
+    for (AActor* actor : actors)
+    {
+        AddActor(actor);
+    }
+}
+
+void URRROS2ActorsRvizMarkerPublisher::AddActor(AActor* InActor)
+{
+    if (false == IsValid(InActor))
+    {
+        return;
+    }
+
+    Actors.Add(InActor);
+    FROSMarker& marker = MarkersMsg.Markers.Add_GetRef(BaseMarker);
+    marker.Ns = InActor->GetName();
+    LastPublishedTransforms.AddDefaulted();
+    InActor->OnDestroyed.AddUniqueDynamic(this, &URRROS2ActorsRvizMarkerPublisher::OnActorDestroyed);
+}
+
+void URRROS2ActorsRvizMarkerPublisher::OnActorSpawned(AActor* InActor)
+{
+    if (ActorClass && InActor->IsA(ActorClass))
+    {
+        AddActor(InActor);
+    }
+}
+
+void URRROS2ActorsRvizMarkerPublisher::OnActorDestroyed(AActor* InActor)
+{
+    const int32 actorIdx = Actors.Find(InActor);
+    if (INDEX_NONE == actorIdx)
+    {
+        return;
+    }
+
+    if (MarkersMsg.Markers.IsValidIndex(actorIdx))
+    {
+        RemovedActorNames.Add(MoveTemp(MarkersMsg.Markers[actorIdx].Ns));
+        MarkersMsg.Markers.RemoveAtSwap(actorIdx, 1, false);
+        LastPublishedTransforms.RemoveAtSwap(actorIdx, 1, false);
+    }
+    Actors.RemoveAtSwap(actorIdx, 1, false);
+}
+
 void URRROS2ActorsRvizMarkerPublisher::UpdateMessage(UROS2GenericMsg* InMessage)
 {
-    if (bUpdateActorsList)
+    if (bUpdateActorsList && (false == ActorSpawnedHandle.IsValid()))
     {
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), ActorClass, Actors);
+        InitActorsList();
+    }
+    else if (MarkersMsg.Markers.Num() != Actors.Num())
+    {
+        // Actors has been modified externally
+        RefreshMarkers();
     }
 
-    FROSMarkerArray msg;
-    BaseMarker.Header.Stamp = URRConversionUtils::FloatToROSStamp(UGameplayStatics::GetTimeSeconds(GetWorld()));
-    for (AActor* actor : Actors)
+    const FROSTime stamp = URRConversionUtils::FloatToROSStamp(UGameplayStatics::GetTimeSeconds(GetWorld()));
+    ChangedMarkersMsg.Markers.Reset();
+    for (int32 i = 0; i < Actors.Num(); ++i)
     {
-        FROSMarker marker = BaseMarker;
-        FTransform tf =
-            URRConversionUtils::TransformUEToROS(URRGeneralUtils::GetRelativeTransform(ReferenceActor, actor->GetTransform()));
-        marker.Ns = actor->GetName();
+        const AActor* actor = Actors[i];
+        if (false == IsValid(actor))
+        {
+            continue;
+        }
+
+        const FTransform relativeTf = URRGeneralUtils::GetRelativeTransform(ReferenceActor, actor->GetTransform());
+        TOptional<FTransform>& lastTf = LastPublishedTransforms[i];
+        if (bPublishOnlyChangedMarkers && lastTf.IsSet() &&
+            lastTf->GetLocation().Equals(relativeTf.GetLocation(), MarkerPositionThreshold) &&
+            lastTf->GetRotation().Equals(relativeTf.GetRotation(), MarkerOrientationThreshold))
+        {
+            continue;
+        }
+        lastTf = relativeTf;
+
+        const FTransform tf = URRConversionUtils::TransformUEToROS(relativeTf);
+        FROSMarker& marker = MarkersMsg.Markers[i];
+        marker.Header.Stamp = stamp;
         marker.Pose.Position = tf.GetTranslation();
         marker.Pose.Orientation = tf.GetRotation();
-        msg.Markers.Add(marker);
+        if (bPublishOnlyChangedMarkers)
+        {
+            ChangedMarkersMsg.Markers.Add(marker);
+        }
     }
 
-    CastChecked<UROS2MarkerArrayMsg>(InMessage)->SetMsg(msg);
+    if (bPublishOnlyChangedMarkers || RemovedActorNames.Num() > 0)
+    {
+        if (false == bPublishOnlyChangedMarkers)
+        {
+            ChangedMarkersMsg.Markers = MarkersMsg.Markers;
+        }
+        for (auto& removedActorName : RemovedActorNames)
+        {
+            FROSMarker& marker = ChangedMarkersMsg.Markers.Add_GetRef(BaseMarker);
+            marker.Header.Stamp = stamp;
+            marker.Ns = MoveTemp(removedActorName);
+            marker.Action = 2;    // visualization_msgs/Marker DELETE
+        }
+        RemovedActorNames.Reset();
+        CastChecked<UROS2MarkerArrayMsg>(InMessage)->SetMsg(ChangedMarkersMsg);
+    }
+    else
+    {
+        CastChecked<UROS2MarkerArrayMsg>(InMessage)->SetMsg(MarkersMsg);
+    }
 }
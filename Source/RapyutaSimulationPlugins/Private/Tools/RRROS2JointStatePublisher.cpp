@@ -0,0 +1,13 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Tools/RRROS2JointStatePublisher.h"
+
+// rclUE
+#include "Msgs/ROS2JointState.h"
+
+URRROS2JointStatePublisher::URRROS2JointStatePublisher()
+{
+    // TopicName could be overridden later by users
+    TopicName = TEXT("joint_states");
+    MsgClass = UROS2JointStateMsg::StaticClass();
+}
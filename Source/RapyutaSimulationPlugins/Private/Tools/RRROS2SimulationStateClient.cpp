@@ -13,6 +13,7 @@
 #include "Srvs/ROS2Attach.h"
 #include "Srvs/ROS2DeleteEntity.h"
 #include "Srvs/ROS2GetEntityState.h"
+#include "Srvs/ROS2SetBool.h"
 #include "Srvs/ROS2SetEntityState.h"
 #include "Srvs/ROS2SpawnEntities.h"
 #include "Srvs/ROS2SpawnEntity.h"
@@ -23,6 +24,7 @@
 #include "Core/RRCoreUtils.h"
 #include "Core/RRROS2GameMode.h"
 #include "Core/RRUObjectUtils.h"
+#include "Tools/RRCommandRecorder.h"
 #include "Tools/ROS2Spawnable.h"
 #include "Tools/SimulationState.h"
 
@@ -57,6 +59,11 @@ void URRROS2SimulationStateClient::Init(UROS2NodeComponent* InROS2Node)
                                &URRROS2SimulationStateClient::SpawnEntitiesSrv);
     ROS2_CREATE_SERVICE_SERVER(
         ROS2Node, this, TEXT("DeleteEntity"), UROS2DeleteEntitySrv::StaticClass(), &URRROS2SimulationStateClient::DeleteEntitySrv);
+    ROS2_CREATE_SERVICE_SERVER(ROS2Node,
+                               this,
+                               TEXT("WorldCheckpoint"),
+                               UROS2SetBoolSrv::StaticClass(),
+                               &URRROS2SimulationStateClient::WorldCheckpointSrv);
 }
 
 void URRROS2SimulationStateClient::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -118,6 +125,25 @@ bool URRROS2SimulationStateClient::CheckSpawnableEntity(const FString& InEntityN
     return CheckEntity<TSubclassOf<AActor>>(ServerSimState->SpawnableEntityTypes, InEntityName, bAllowEmpty);
 }
 
+template<typename TRequest>
+bool URRROS2SimulationStateClient::ShouldApplyCommand(const ERRRecordedCommandType InType,
+                                                      const TRequest& InRequest,
+                                                      const int32 InNetworkPlayerId)
+{
+    URRCommandRecorder* recorder = GetWorld()->GetSubsystem<URRCommandRecorder>();
+    if (nullptr == recorder)
+    {
+        return true;
+    }
+    if (recorder->IsReplaying())
+    {
+        UE_LOG_WITH_INFO_NAMED(LogRapyutaCore, Log, TEXT("Replaying recorded commands -> live request ignored"));
+        return false;
+    }
+    recorder->RecordSimStateRequest(InType, InRequest, InNetworkPlayerId);
+    return true;
+}
+
 void URRROS2SimulationStateClient::GetEntityStateSrv(UROS2GenericSrv* InService)
 {
     UROS2GetEntityStateSrv* GetEntityStateService = Cast<UROS2GetEntityStateSrv>(InService);
@@ -168,7 +194,10 @@ void URRROS2SimulationStateClient::SetEntityStateSrv(UROS2GenericSrv* InService)
 
 void URRROS2SimulationStateClient::ServerSetEntityState_Implementation(const FROSSetEntityStateReq& InRequest)
 {
-    ServerSimState->ServerSetEntityState(InRequest);
+    if (ShouldApplyCommand(ERRRecordedCommandType::SET_ENTITY_STATE, InRequest))
+    {
+        ServerSimState->ServerSetEntityState(InRequest);
+    }
 }
 
 void URRROS2SimulationStateClient::AttachSrv(UROS2GenericSrv* InService)
@@ -201,7 +230,10 @@ void URRROS2SimulationStateClient::AttachSrv(UROS2GenericSrv* InService)
 
 void URRROS2SimulationStateClient::ServerAttach_Implementation(const FROSAttachReq& InRequest)
 {
-    ServerSimState->ServerAttach(InRequest);
+    if (ShouldApplyCommand(ERRRecordedCommandType::ATTACH, InRequest))
+    {
+        ServerSimState->ServerAttach(InRequest);
+    }
 }
 
 FROSSpawnEntityRes URRROS2SimulationStateClient::SpawnEntityImpl(FROSSpawnEntityReq& InRequest)
@@ -297,7 +329,10 @@ void URRROS2SimulationStateClient::SpawnEntitiesSrv(UROS2GenericSrv* InService)
 
 void URRROS2SimulationStateClient::ServerSpawnEntity_Implementation(const FROSSpawnEntityReq& InRequest)
 {
-    ServerSimState->ServerSpawnEntity(InRequest, NetworkPlayerId);
+    if (ShouldApplyCommand(ERRRecordedCommandType::SPAWN_ENTITY, InRequest, NetworkPlayerId))
+    {
+        ServerSimState->ServerSpawnEntity(InRequest, NetworkPlayerId);
+    }
 }
 
 // Currently this code doesnt seem to trigger the ROS 2 Service Response... keeping this in since if
@@ -382,7 +417,72 @@ void URRROS2SimulationStateClient::DeleteEntitySrv(UROS2GenericSrv* InService)
 
 void URRROS2SimulationStateClient::ServerDeleteEntity_Implementation(const FROSDeleteEntityReq& InRequest)
 {
-    ServerSimState->ServerDeleteEntity(InRequest);
+    if (ShouldApplyCommand(ERRRecordedCommandType::DELETE_ENTITY, InRequest))
+    {
+        ServerSimState->ServerDeleteEntity(InRequest);
+    }
+}
+
+void URRROS2SimulationStateClient::WorldCheckpointSrv(UROS2GenericSrv* InService)
+{
+    UROS2SetBoolSrv* worldCheckpointService = Cast<UROS2SetBoolSrv>(InService);
+
+    FROSSetBoolReq request;
+    worldCheckpointService->GetRequest(request);
+
+    FROSSetBoolRes response;
+    if (IsNetMode(NM_Client))
+    {
+        // RPC to server, of which the result is not known here
+        ServerWorldCheckpoint(request.bData);
+        response.bSuccess = true;
+        response.Message = request.bData ? TEXT("Requested saving world checkpoint") : TEXT("Requested restoring world checkpoint");
+    }
+    else
+    {
+        response.bSuccess = ApplyWorldCheckpoint(request.bData, response.Message);
+    }
+    worldCheckpointService->SetResponse(response);
+}
+
+void URRROS2SimulationStateClient::ServerWorldCheckpoint_Implementation(const bool bInSave)
+{
+    FString message;
+    ApplyWorldCheckpoint(bInSave, message);
+}
+
+bool URRROS2SimulationStateClient::ApplyWorldCheckpoint(const bool bInSave, FString& OutMessage)
+{
+    URRCommandRecorder* recorder = GetWorld()->GetSubsystem<URRCommandRecorder>();
+    if (recorder)
+    {
+        if (recorder->IsReplaying())
+        {
+            OutMessage = TEXT("Replaying recorded commands -> live request ignored");
+            UE_LOG_WITH_INFO_NAMED(LogRapyutaCore, Log, TEXT("%s"), *OutMessage);
+            return false;
+        }
+        recorder->RecordWorldCheckpoint(bInSave);
+    }
+
+    bool bSuccess = false;
+    if (bInSave)
+    {
+        bSuccess = ServerSimState->ServerSaveCheckpoint();
+        OutMessage = bSuccess ? TEXT("Saved world checkpoint") : TEXT("Failed to save world checkpoint");
+    }
+    else
+    {
+        const int32 restoredEntitiesNum = ServerSimState->ServerRestoreCheckpoint();
+        bSuccess = (INDEX_NONE != restoredEntitiesNum);
+        OutMessage = bSuccess ? FString::Printf(TEXT("Restored world checkpoint of %d entities"), restoredEntitiesNum)
+                              : TEXT("Failed to restore world checkpoint: none has been saved");
+    }
+    if (false == bSuccess)
+    {
+        UE_LOG_WITH_INFO_NAMED(LogRapyutaCore, Error, TEXT("%s"), *OutMessage);
+    }
+    return bSuccess;
 }
 
 void URRROS2SimulationStateClient::ServerAddEntity_Implementation(AActor* InEntity)
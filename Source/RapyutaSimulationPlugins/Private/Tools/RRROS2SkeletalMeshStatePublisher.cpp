@@ -22,6 +22,26 @@ URRROS2SkeletalMeshStatePublisher::URRROS2SkeletalMeshStatePublisher()
     SetDefaultDelegates();    //use UpdateMessage as update delegate
 }
 
+bool URRROS2SkeletalMeshStatePublisher::InitializeWithROS2(UROS2NodeComponent* InROS2Node)
+{
+    // Always publishes the owner's entity state, bone states are published by BoneTFPublisher instead
+    bPublishAllStates = false;
+
+    bool res = Super::InitializeWithROS2(InROS2Node);
+
+    if (res && bPublishBoneTF && (nullptr == BoneTFPublisher))
+    {
+        // No timer of its own: bone TFs are published along with the entity state in UpdateMessage, thus never stale
+        BoneTFPublisher = NewObject<URRROS2TFsPublisher>(this, TEXT("BoneTFPublisher"));
+        BoneTFPublisher->PublicationFrequencyHz = -1;
+        BoneTFPublisher->InitializeWithROS2(InROS2Node);
+        BoneTFPublisher->Init();
+        InitBoneBuffer();
+    }
+
+    return res;
+}
+
 void URRROS2SkeletalMeshStatePublisher::SetTargetRobot(ARobotVehicle* InRobot)
 {
     Super::SetTargetRobot(InRobot);
@@ -35,6 +55,7 @@ void URRROS2SkeletalMeshStatePublisher::SetTargetRobot(ARobotVehicle* InRobot)
         SkeletalMeshComp = skeletalMeshComponents[0];
         const auto bonesNum = SkeletalMeshComp->GetBoneSpaceTransforms().Num();
         UE_LOG_WITH_INFO(LogRapyutaCore, Log, TEXT("[%s] has %d bones"), *SkeletalMeshComp->GetName(), bonesNum);
+        InitBoneBuffer();
     }
     else
     {
@@ -43,6 +64,82 @@ void URRROS2SkeletalMeshStatePublisher::SetTargetRobot(ARobotVehicle* InRobot)
     }
 }
 
+bool URRROS2SkeletalMeshStatePublisher::InitBoneBuffer()
+{
+    BoneIndices.Reset();
+    if ((nullptr == SkeletalMeshComp) || (nullptr == BoneTFPublisher))
+    {
+        return false;
+    }
+
+    // Resolve bone indices once, so bone transforms need no name lookup upon publishing
+    if (BoneNames.Num() > 0)
+    {
+        BoneIndices.Reserve(BoneNames.Num());
+        for (const auto& boneName : BoneNames)
+        {
+            const int32 boneIndex = SkeletalMeshComp->GetBoneIndex(boneName);
+            if (INDEX_NONE == boneIndex)
+            {
+                UE_LOG_WITH_INFO(
+                    LogRapyutaCore, Warning, TEXT("[%s] has no bone named %s"), *SkeletalMeshComp->GetName(), *boneName.ToString());
+                continue;
+            }
+            BoneIndices.Add(boneIndex);
+        }
+    }
+    else
+    {
+        const int32 bonesNum = SkeletalMeshComp->GetNumBones();
+        BoneIndices.Reserve(bonesNum);
+        for (int32 boneIndex = 0; boneIndex < bonesNum; ++boneIndex)
+        {
+            BoneIndices.Add(boneIndex);
+        }
+    }
+
+    // Preallocate transforms with their frame ids
+    auto& transforms = BoneTFPublisher->TFMsg.Transforms;
+    transforms.SetNum(BoneIndices.Num());
+    for (int32 i = 0; i < BoneIndices.Num(); ++i)
+    {
+        transforms[i].Header.FrameId = FrameId;
+        transforms[i].ChildFrameId =
+            URRGeneralUtils::ComposeROSFullFrameId(FrameId, *SkeletalMeshComp->GetBoneName(BoneIndices[i]).ToString());
+    }
+
+    return (BoneIndices.Num() > 0);
+}
+
+bool URRROS2SkeletalMeshStatePublisher::UpdateBoneTFs()
+{
+    if ((nullptr == BoneTFPublisher) || (nullptr == SkeletalMeshComp))
+    {
+        return false;
+    }
+
+    auto& transforms = BoneTFPublisher->TFMsg.Transforms;
+    if ((0 == BoneIndices.Num()) || (transforms.Num() != BoneIndices.Num()))
+    {
+        return false;
+    }
+
+    // Component space -> owner robot frame, computed once for all bones
+    const FTransform compToRobot = SkeletalMeshComp->GetComponentTransform().GetRelativeTransform(Robot->GetTransform());
+    const FROSTime stamp = URRConversionUtils::FloatToROSStamp(UGameplayStatics::GetTimeSeconds(GetWorld()));
+    const TArray<FTransform>& componentSpaceTransforms = SkeletalMeshComp->GetComponentSpaceTransforms();
+    for (int32 i = 0; i < BoneIndices.Num(); ++i)
+    {
+        const int32 boneIndex = BoneIndices[i];
+        if (componentSpaceTransforms.IsValidIndex(boneIndex))
+        {
+            transforms[i].Header.Stamp = stamp;
+            transforms[i].Transform = URRConversionUtils::TransformUEToROS(componentSpaceTransforms[boneIndex] * compToRobot);
+        }
+    }
+    return true;
+}
+
 void URRROS2SkeletalMeshStatePublisher::UpdateMessage(UROS2GenericMsg* InMessage)
 {
     // (NOTE) Robot could be reset when ROS AI Controller, which owns this publisher, unposses it.
@@ -53,11 +150,6 @@ void URRROS2SkeletalMeshStatePublisher::UpdateMessage(UROS2GenericMsg* InMessage
 
     UROS2EntityStateMsg* stateMsg = CastChecked<UROS2EntityStateMsg>(InMessage);
 
-#if 0    // To be enabled when bone transform is used in the message content
-    const TArray<FTransform> boneTransforms = SkeletalMeshComp->GetBoneSpaceTransforms();
-    if (boneTransforms.IsValidIndex(Idx))
-    {
-#endif
     const FTransform& robotTransform = Robot->GetTransform();
 
     FROSEntityState data;
@@ -82,13 +174,11 @@ void URRROS2SkeletalMeshStatePublisher::UpdateMessage(UROS2GenericMsg* InMessage
     data.ReferenceFrame = ReferenceFrameId;
     stateMsg->SetMsg(data);
 
-#if 0
-    if ((++Idx) >= boneTransforms.Num())
+    if (bPublishBoneTF && UpdateBoneTFs())
     {
-        Idx = 0;
+        BoneTFPublisher->PublishTFs();
     }
-}
-#endif
+
     // DrawDebugDirectionalArrow(GetWorld(), data.position, data.position + data.orientation.GetForwardVector()*100, 100,
     // FColor(255, 0, 0, 255), false, 10, 1, 10);
 }
@@ -23,6 +23,36 @@ void URRROS2StatePublisher::SetTargetRobot(ARobotVehicle* InRobot)
     Robot = InRobot;
 }
 
+bool URRROS2StatePublisher::InitializeWithROS2(UROS2NodeComponent* InROS2Node)
+{
+    if (false == bPublishAllStates)
+    {
+        return Super::InitializeWithROS2(InROS2Node);
+    }
+
+    // Nothing is published to [TopicName], of which the message type stays as is.
+    // Batched states are published to [AllStatesTopicName] instead, by AllStatesTimerHandle.
+    const float publicationFrequencyHz = PublicationFrequencyHz;
+    PublicationFrequencyHz = -1;
+    const bool res = Super::InitializeWithROS2(InROS2Node);
+    if (res && (nullptr == AllStatesPublisher))
+    {
+        AllStatesPublisher = NewObject<URRROS2TFsPublisher>(this, TEXT("AllStatesPublisher"));
+        AllStatesPublisher->bKeepTopicName = true;
+        AllStatesPublisher->TopicName = AllStatesTopicName;
+        AllStatesPublisher->QoS = UROS2QoS::DynamicBroadcaster;
+        AllStatesPublisher->PublicationFrequencyHz = -1;
+        AllStatesPublisher->InitializeWithROS2(InROS2Node);
+        AllStatesPublisher->Init();
+        if (publicationFrequencyHz > 0)
+        {
+            GetWorld()->GetTimerManager().SetTimer(
+                AllStatesTimerHandle, this, &URRROS2StatePublisher::PublishAllStates, 1.f / publicationFrequencyHz, true);
+        }
+    }
+    return res;
+}
+
 void URRROS2StatePublisher::UpdateMessage(UROS2GenericMsg* InMessage)
 {
     if (StatesToPublish.IsValidIndex(Idx))
@@ -36,6 +66,62 @@ void URRROS2StatePublisher::UpdateMessage(UROS2GenericMsg* InMessage)
     }
 }
 
+void URRROS2StatePublisher::PublishAllStates()
+{
+    if (nullptr == AllStatesPublisher)
+    {
+        return;
+    }
+
+    const int32 statesNum = StatesToPublish.Num();
+    if (LastPublishedPoses.Num() != statesNum)
+    {
+        // Entities have been added/removed: all of them are dirty
+        LastPublishedPoses.SetNum(statesNum);
+        DirtyStates.Init(true, statesNum);
+    }
+
+    // Reuse transforms' allocation, only growing as needed
+    FROSTFMsg& allStatesMsg = AllStatesPublisher->TFMsg;
+    const FROSTime stamp = URRConversionUtils::FloatToROSStamp(UGameplayStatics::GetTimeSeconds(GetWorld()));
+    int32 msgIdx = 0;
+    for (int32 i = 0; i < statesNum; ++i)
+    {
+        const FROSEntityState& state = StatesToPublish[i];
+        FROSPose& lastPose = LastPublishedPoses[i];
+        if ((false == bPublishOnlyChangedStates) ||
+            (false == state.Pose.Position.Equals(lastPose.Position, ChangedPositionTolerance)) ||
+            (false == state.Pose.Orientation.Equals(lastPose.Orientation, ChangedOrientationTolerance)))
+        {
+            DirtyStates[i] = true;
+        }
+        if (false == DirtyStates[i])
+        {
+            continue;
+        }
+        lastPose = state.Pose;
+
+        if (false == allStatesMsg.Transforms.IsValidIndex(msgIdx))
+        {
+            allStatesMsg.Transforms.AddDefaulted();
+        }
+        FROSTFStamped& tfData = allStatesMsg.Transforms[msgIdx++];
+        tfData.Header.Stamp = stamp;
+        tfData.Header.FrameId = state.ReferenceFrame;
+        tfData.ChildFrameId = state.Name;
+        tfData.Transform.SetTranslation(state.Pose.Position);
+        tfData.Transform.SetRotation(state.Pose.Orientation);
+    }
+    allStatesMsg.Transforms.SetNum(msgIdx, false);
+
+    // Skipped if nothing has changed
+    AllStatesPublisher->PublishTFs();
+    if (statesNum > 0)
+    {
+        DirtyStates.SetRange(0, statesNum, false);
+    }
+}
+
 void URRROS2StatePublisher::AddEntityToPublish(const FString& InName,
                                                const FVector& InPosition,
                                                const FRotator& InOrientation,
@@ -6,6 +6,21 @@
 #include "Msgs/ROS2TFMsg.h"
 #include "rclcUtilities.h"
 
+// (NOTE) [/tf, /tf_static] has its [tf_prefix] only for frame ids, not topics
+static void SetTFTopicAndQoS(UROS2Publisher* InPublisher, const bool bInIsStatic)
+{
+    if (bInIsStatic)
+    {
+        InPublisher->TopicName = TEXT("/tf_static");
+        InPublisher->QoS = UROS2QoS::StaticBroadcaster;
+    }
+    else
+    {
+        InPublisher->TopicName = TEXT("/tf");
+        InPublisher->QoS = UROS2QoS::DynamicBroadcaster;
+    }
+}
+
 URRROS2TFPublisher::URRROS2TFPublisher()
 {
     PublicationFrequencyHz = 50;
@@ -15,17 +30,7 @@ URRROS2TFPublisher::URRROS2TFPublisher()
 
 bool URRROS2TFPublisher::InitializeWithROS2(UROS2NodeComponent* InROS2Node)
 {
-    // (NOTE) [/tf, /tf_static] has its [tf_prefix] only for frame ids, not topics
-    if (IsStatic)
-    {
-        TopicName = TEXT("/tf_static");
-        QoS = UROS2QoS::StaticBroadcaster;
-    }
-    else
-    {
-        TopicName = TEXT("/tf");
-        QoS = UROS2QoS::DynamicBroadcaster;
-    }
+    SetTFTopicAndQoS(this, IsStatic);
     return Super::InitializeWithROS2(InROS2Node);
 }
 
@@ -52,3 +57,32 @@ void URRROS2TFPublisher::UpdateMessage(UROS2GenericMsg* InMessage)
 
     CastChecked<UROS2TFMsgMsg>(InMessage)->SetMsg(tf);
 }
+
+URRROS2TFsPublisher::URRROS2TFsPublisher()
+{
+    PublicationFrequencyHz = 50;
+    MsgClass = UROS2TFMsgMsg::StaticClass();
+    SetDefaultDelegates();    //use UpdateMessage as update delegate
+}
+
+bool URRROS2TFsPublisher::InitializeWithROS2(UROS2NodeComponent* InROS2Node)
+{
+    if (false == bKeepTopicName)
+    {
+        SetTFTopicAndQoS(this, IsStatic);
+    }
+    return Super::InitializeWithROS2(InROS2Node);
+}
+
+void URRROS2TFsPublisher::PublishTFs()
+{
+    if (TFMsg.Transforms.Num() > 0)
+    {
+        Publish<UROS2TFMsgMsg, FROSTFMsg>(TFMsg);
+    }
+}
+
+void URRROS2TFsPublisher::UpdateMessage(UROS2GenericMsg* InMessage)
+{
+    CastChecked<UROS2TFMsgMsg>(InMessage)->SetMsg(TFMsg);
+}
@@ -0,0 +1,288 @@
+// Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+
+#include "Tools/RRWorldCheckpoint.h"
+
+// UE
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/MovementComponent.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRActorCommon.h"
+#include "Drives/RRJointComponent.h"
+#include "Drives/RobotVehicleMovementComponent.h"
+#include "Robots/RRBaseRobot.h"
+#include "Sensors/RRBaseOdomComponent.h"
+
+void FRRWorldCheckpoint::SerializeJointState(FArchive& InOutAr, URRJointComponent* InJoint)
+{
+    FVector position = InJoint->Position;
+    FRotator orientation = InJoint->Orientation;
+    FVector linearVelocity = InJoint->LinearVelocity;
+    FVector angularVelocity = InJoint->AngularVelocity;
+    FVector positionTarget = InJoint->PositionTarget;
+    FRotator orientationTarget = InJoint->OrientationTarget;
+    FVector linearVelocityTarget = InJoint->LinearVelocityTarget;
+    FVector angularVelocityTarget = InJoint->AngularVelocityTarget;
+    InOutAr << position << orientation << linearVelocity << angularVelocity;
+    InOutAr << positionTarget << orientationTarget << linearVelocityTarget << angularVelocityTarget;
+
+    if (InOutAr.IsLoading())
+    {
+        InJoint->SetPose(position, orientation);
+        InJoint->SetVelocity(linearVelocity, angularVelocity);
+        // Targets last, since setting pose/velocity may update them
+        InJoint->PositionTarget = positionTarget;
+        InJoint->OrientationTarget = orientationTarget;
+        InJoint->LinearVelocityTarget = linearVelocityTarget;
+        InJoint->AngularVelocityTarget = angularVelocityTarget;
+    }
+}
+
+bool FRRWorldCheckpoint::Capture(UWorld* InWorld, const TMap<FString, AActor*>& InEntities)
+{
+    Reset();
+    if (nullptr == InWorld)
+    {
+        return false;
+    }
+
+    FMemoryWriter writer(Data, true);
+    uint32 magic = MAGIC;
+    uint32 version = VERSION;
+    double timeSeconds = InWorld->TimeSeconds;
+    double unpausedTimeSeconds = InWorld->UnpausedTimeSeconds;
+    writer << magic << version << timeSeconds << unpausedTimeSeconds;
+    const int64 entityNumOffset = writer.Tell();
+    writer << EntityNum;
+
+    for (const auto& [entityName, entity] : InEntities)
+    {
+        if (false == ::IsValid(entity))
+        {
+            continue;
+        }
+
+        // Entity state block, prefixed by its size which is patched after serializing it
+        FString name = entityName;
+        int64 blockSize = 0;
+        writer << name;
+        const int64 blockSizeOffset = writer.Tell();
+        writer << blockSize;
+
+        bool bMatched = false;
+        SerializeEntityState(writer, entity, bMatched);
+
+        const int64 blockEnd = writer.Tell();
+        blockSize = blockEnd - blockSizeOffset - sizeof(int64);
+        writer.Seek(blockSizeOffset);
+        writer << blockSize;
+        writer.Seek(blockEnd);
+        EntityNum++;
+    }
+
+    const int64 dataEnd = writer.Tell();
+    writer.Seek(entityNumOffset);
+    writer << EntityNum;
+    writer.Seek(dataEnd);
+
+    TimeSeconds = timeSeconds;
+    return true;
+}
+
+int32 FRRWorldCheckpoint::Restore(UWorld* InWorld, const TMap<FString, AActor*>& InEntities, const bool bInRestoreClock) const
+{
+    if ((nullptr == InWorld) || (false == IsValid()))
+    {
+        return INDEX_NONE;
+    }
+
+    FMemoryReader reader(Data, true);
+    uint32 magic = 0;
+    uint32 version = 0;
+    double timeSeconds = 0.0;
+    double unpausedTimeSeconds = 0.0;
+    int32 entityNum = 0;
+    reader << magic << version;
+    if ((MAGIC != magic) || (VERSION != version))
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Error, TEXT("Invalid checkpoint data, of version [%u] vs [%u]"), version, VERSION);
+        return INDEX_NONE;
+    }
+    reader << timeSeconds << unpausedTimeSeconds << entityNum;
+
+    int32 restoredNum = 0;
+    for (int32 i = 0; (i < entityNum) && (false == reader.IsError()); ++i)
+    {
+        FString entityName;
+        int64 blockSize = 0;
+        reader << entityName << blockSize;
+        const int64 blockEnd = reader.Tell() + blockSize;
+
+        AActor* entity = InEntities.FindRef(entityName);
+        if (::IsValid(entity))
+        {
+            bool bMatched = false;
+            SerializeEntityState(reader, entity, bMatched, bInRestoreClock);
+            if (bMatched)
+            {
+                restoredNum++;
+            }
+            else
+            {
+                UE_LOG_WITH_INFO(
+                    LogRapyutaCore, Warning, TEXT("[%s] components have changed since checkpoint -> partially restored"), *entityName);
+            }
+        }
+        else
+        {
+            UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("[%s] not found -> skipped"), *entityName);
+        }
+        reader.Seek(blockEnd);
+    }
+
+    if (bInRestoreClock)
+    {
+        InWorld->TimeSeconds = timeSeconds;
+        InWorld->UnpausedTimeSeconds = unpausedTimeSeconds;
+    }
+    return restoredNum;
+}
+
+void FRRWorldCheckpoint::SerializeEntityState(FArchive& InOutAr, AActor* InEntity, bool& bOutMatched, const bool bInRestoreClock)
+{
+    const bool bLoading = InOutAr.IsLoading();
+    bOutMatched = false;
+
+    // Actor transform
+    FTransform actorTransform = InEntity->GetActorTransform();
+    InOutAr << actorTransform;
+    if (bLoading)
+    {
+        InEntity->SetActorTransform(actorTransform, false, nullptr, ETeleportType::ResetPhysics);
+    }
+
+    // Physics-simulating primitives, eg robot links
+    TInlineComponentArray<UPrimitiveComponent*> primComps(InEntity);
+    primComps.RemoveAll([](const UPrimitiveComponent* InPrimComp) { return false == InPrimComp->IsSimulatingPhysics(); });
+    int32 primCompNum = primComps.Num();
+    InOutAr << primCompNum;
+    if (primCompNum != primComps.Num())
+    {
+        return;
+    }
+    for (auto* primComp : primComps)
+    {
+        FTransform compTransform = primComp->GetComponentTransform();
+        FVector linearVel = primComp->GetPhysicsLinearVelocity();
+        FVector angularVel = primComp->GetPhysicsAngularVelocityInDegrees();
+        InOutAr << compTransform << linearVel << angularVel;
+        if (bLoading)
+        {
+            primComp->SetWorldTransform(compTransform, false, nullptr, ETeleportType::TeleportPhysics);
+            primComp->SetPhysicsLinearVelocity(linearVel);
+            primComp->SetPhysicsAngularVelocityInDegrees(angularVel);
+        }
+    }
+
+    // Movement
+    UMovementComponent* moveComp = InEntity->FindComponentByClass<UMovementComponent>();
+    bool bHasMoveComp = (nullptr != moveComp);
+    InOutAr << bHasMoveComp;
+    if (bHasMoveComp != (nullptr != moveComp))
+    {
+        return;
+    }
+    if (moveComp)
+    {
+        auto* vehicleMoveComp = Cast<URobotVehicleMovementComponent>(moveComp);
+        FVector velocity = moveComp->Velocity;
+        FVector angularVelocity = vehicleMoveComp ? vehicleMoveComp->AngularVelocity : FVector::ZeroVector;
+        InOutAr << velocity << angularVelocity;
+        if (bLoading)
+        {
+            moveComp->Velocity = velocity;
+            moveComp->UpdateComponentVelocity();
+            if (vehicleMoveComp)
+            {
+                vehicleMoveComp->AngularVelocity = angularVelocity;
+            }
+        }
+
+        // Drive internal state
+        bool bIsVehicleMoveComp = (nullptr != vehicleMoveComp);
+        InOutAr << bIsVehicleMoveComp;
+        if (bIsVehicleMoveComp != (nullptr != vehicleMoveComp))
+        {
+            return;
+        }
+        if (vehicleMoveComp)
+        {
+            vehicleMoveComp->SerializeDriveState(InOutAr);
+        }
+    }
+
+    // Robot's target velocities & joints
+    ARRBaseRobot* robot = Cast<ARRBaseRobot>(InEntity);
+    bool bIsRobot = (nullptr != robot);
+    InOutAr << bIsRobot;
+    if (bIsRobot != (nullptr != robot))
+    {
+        return;
+    }
+    if (robot)
+    {
+        FVector targetLinearVel = robot->TargetLinearVel;
+        FVector targetAngularVel = robot->TargetAngularVel;
+        InOutAr << targetLinearVel << targetAngularVel;
+
+        int32 jointNum = robot->Joints.Num();
+        InOutAr << jointNum;
+        if (jointNum != robot->Joints.Num())
+        {
+            return;
+        }
+        if (bLoading)
+        {
+            robot->SetLocalLinearVel(targetLinearVel);
+            robot->SetLocalAngularVel(targetAngularVel);
+            for (int32 i = 0; i < jointNum; ++i)
+            {
+                FString jointName;
+                InOutAr << jointName;
+                URRJointComponent* joint = robot->Joints.FindRef(jointName);
+                if (nullptr == joint)
+                {
+                    return;
+                }
+                SerializeJointState(InOutAr, joint);
+            }
+        }
+        else
+        {
+            for (auto& [jointName, joint] : robot->Joints)
+            {
+                FString name = jointName;
+                InOutAr << name;
+                SerializeJointState(InOutAr, joint);
+            }
+        }
+    }
+
+    // Odometry
+    TInlineComponentArray<URRBaseOdomComponent*> odomComps(InEntity);
+    int32 odomCompNum = odomComps.Num();
+    InOutAr << odomCompNum;
+    if (odomCompNum != odomComps.Num())
+    {
+        return;
+    }
+    for (auto* odomComp : odomComps)
+    {
+        odomComp->SerializeOdomState(InOutAr, bInRestoreClock);
+    }
+
+    bOutMatched = true;
+}
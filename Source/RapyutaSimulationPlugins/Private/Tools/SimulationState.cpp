@@ -32,11 +32,213 @@ ASimulationState::ASimulationState()
     bAlwaysRelevant = true;
 }
 
+void ASimulationState::PostInitProperties()
+{
+    Super::PostInitProperties();
+    EntityList.Owner = this;
+    SpawnableEntityInfoList.Owner = this;
+    RobotPoseList.Owner = this;
+}
+
+void FRREntityInfo::PostReplicatedAdd(const FRREntityInfoList& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->SpawnableEntityTypes.Emplace(EntityTypeName, EntityClass);
+    }
+}
+
+void FRREntityInfo::PostReplicatedChange(const FRREntityInfoList& InArraySerializer)
+{
+    PostReplicatedAdd(InArraySerializer);
+}
+
+void FRREntityListItem::PostReplicatedAdd(const FRREntityList& InArraySerializer)
+{
+    // NOTE: [Entity] could be still unresolved here if its actor has not been replicated yet, in which case it is registered
+    // later upon [PostReplicatedChange()]
+    if (InArraySerializer.Owner && IsValid(Entity))
+    {
+        InArraySerializer.Owner->ClientAddEntity(Entity);
+    }
+}
+
+void FRREntityListItem::PostReplicatedChange(const FRREntityList& InArraySerializer)
+{
+    PostReplicatedAdd(InArraySerializer);
+}
+
+void FRREntityListItem::PreReplicatedRemove(const FRREntityList& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->RemoveEntity(Entity);
+    }
+}
+
+static void SerializePackedInt(FArchive& Ar, int32& InOutValue)
+{
+    // ZigZag encoding, so that small negative values are also packed into few bytes
+    uint32 zigZag = (static_cast<uint32>(InOutValue) << 1) ^ static_cast<uint32>(InOutValue >> 31);
+    Ar.SerializeIntPacked(zigZag);
+    if (Ar.IsLoading())
+    {
+        InOutValue = static_cast<int32>(zigZag >> 1) ^ -static_cast<int32>(zigZag & 1);
+    }
+}
+
+static FIntVector QuantizeVector(const FVector& InVector, const float InPrecision)
+{
+    return FIntVector(FMath::RoundToInt(InVector.X / InPrecision),
+                      FMath::RoundToInt(InVector.Y / InPrecision),
+                      FMath::RoundToInt(InVector.Z / InPrecision));
+}
+
+void FRRQuantizedRobotPose::Quantize(const FTransform& InTransform,
+                                     const FVector& InLinearVel,
+                                     const FVector& InAngularVel,
+                                     const float InLocationPrecision,
+                                     const float InVelocityPrecision,
+                                     const bool bInIs2D)
+{
+    const FRotator rotation = InTransform.Rotator();
+    bIs2D = bInIs2D;
+    Location = QuantizeVector(InTransform.GetLocation(), InLocationPrecision);
+    Yaw = FRotator::CompressAxisToShort(rotation.Yaw);
+    Pitch = bIs2D ? 0 : FRotator::CompressAxisToShort(rotation.Pitch);
+    Roll = bIs2D ? 0 : FRotator::CompressAxisToShort(rotation.Roll);
+    LinearVel = QuantizeVector(InLinearVel, InVelocityPrecision);
+    AngularVel = QuantizeVector(InAngularVel, InVelocityPrecision);
+    if (bIs2D)
+    {
+        Location.Z = 0;
+        LinearVel.Z = 0;
+        AngularVel.X = 0;
+        AngularVel.Y = 0;
+    }
+}
+
+void FRRQuantizedRobotPose::Dequantize(FVector& OutLocation,
+                                       FRotator& OutRotation,
+                                       FVector& OutLinearVel,
+                                       FVector& OutAngularVel,
+                                       const float InLocationPrecision,
+                                       const float InVelocityPrecision) const
+{
+    // NOTE: In 2D mode, Z location, pitch & roll are kept as they are in the out params
+    OutLocation.X = Location.X * InLocationPrecision;
+    OutLocation.Y = Location.Y * InLocationPrecision;
+    OutRotation.Yaw = FRotator::DecompressAxisFromShort(Yaw);
+    if (false == bIs2D)
+    {
+        OutLocation.Z = Location.Z * InLocationPrecision;
+        OutRotation.Pitch = FRotator::DecompressAxisFromShort(Pitch);
+        OutRotation.Roll = FRotator::DecompressAxisFromShort(Roll);
+    }
+    OutLinearVel = FVector(LinearVel) * InVelocityPrecision;
+    OutAngularVel = FVector(AngularVel) * InVelocityPrecision;
+}
+
+bool FRRQuantizedRobotPose::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    uint8 bIs2DBit = bIs2D ? 1 : 0;
+    Ar.SerializeBits(&bIs2DBit, 1);
+    bIs2D = (bIs2DBit != 0);
+
+    SerializePackedInt(Ar, Location.X);
+    SerializePackedInt(Ar, Location.Y);
+    Ar << Yaw;
+    SerializePackedInt(Ar, LinearVel.X);
+    SerializePackedInt(Ar, LinearVel.Y);
+    SerializePackedInt(Ar, AngularVel.Z);
+    if (false == bIs2D)
+    {
+        SerializePackedInt(Ar, Location.Z);
+        Ar << Pitch;
+        Ar << Roll;
+        SerializePackedInt(Ar, LinearVel.Z);
+        SerializePackedInt(Ar, AngularVel.X);
+        SerializePackedInt(Ar, AngularVel.Y);
+    }
+    bOutSuccess = true;
+    return true;
+}
+
+void FRRRobotPoseItem::PostReplicatedAdd(const FRRRobotPoseList& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->ClientApplyRobotPose(*this);
+    }
+}
+
+void FRRRobotPoseItem::PostReplicatedChange(const FRRRobotPoseList& InArraySerializer)
+{
+    PostReplicatedAdd(InArraySerializer);
+}
+
 void ASimulationState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     DOREPLIFETIME(ASimulationState, EntityList);
     DOREPLIFETIME(ASimulationState, SpawnableEntityInfoList);
+    DOREPLIFETIME(ASimulationState, RobotPoseList);
+    DOREPLIFETIME(ASimulationState, bReplicateRobotPoses2D);
+    DOREPLIFETIME(ASimulationState, RobotPoseLocationPrecision);
+    DOREPLIFETIME(ASimulationState, RobotPoseVelocityPrecision);
+}
+
+void ASimulationState::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+    if (bReplicateRobotPoses && HasAuthority())
+    {
+        ServerUpdateRobotPoses();
+    }
+}
+
+void ASimulationState::ServerUpdateRobotPoses()
+{
+    // NOTE: Dirty items are only sent upon the next net update, thus all changed poses are coalesced into a single bunch
+    for (auto& item : RobotPoseList.Items)
+    {
+        if (false == IsValid(item.Robot))
+        {
+            continue;
+        }
+        FRRQuantizedRobotPose pose;
+        pose.Quantize(item.Robot->GetActorTransform(),
+                      item.Robot->TargetLinearVel,
+                      item.Robot->TargetAngularVel,
+                      RobotPoseLocationPrecision,
+                      RobotPoseVelocityPrecision,
+                      bReplicateRobotPoses2D);
+        if (pose != item.Pose)
+        {
+            item.Pose = pose;
+            RobotPoseList.MarkItemDirty(item);
+        }
+    }
+}
+
+void ASimulationState::ClientApplyRobotPose(const FRRRobotPoseItem& InItem)
+{
+    ARRBaseRobot* robot = InItem.Robot;
+    if (false == IsValid(robot))
+    {
+        return;
+    }
+
+    FVector location = robot->GetActorLocation();
+    FRotator rotation = robot->GetActorRotation();
+    FVector linearVel;
+    FVector angularVel;
+    InItem.Pose.Dequantize(location, rotation, linearVel, angularVel, RobotPoseLocationPrecision, RobotPoseVelocityPrecision);
+    robot->SetActorLocationAndRotation(location, rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+    // Target vels let the client's movement component extrapolate the robot motion in between updates
+    robot->TargetLinearVel = linearVel;
+    robot->TargetAngularVel = angularVel;
 }
 
 bool ASimulationState::VerifyIsServerCall(const FString& InFunctionName)
@@ -82,101 +284,129 @@ void ASimulationState::InitEntities()
 
 void ASimulationState::ServerAddEntity(AActor* InEntity)
 {
-    if (false == IsValid(InEntity))
+    if (false == IsValid(InEntity) || RegisteredEntities.Contains(InEntity))
     {
         return;
     }
 
     GetSpawnableEntityInfoList();
+    RegisteredEntities.Add(InEntity);
     Entities.Emplace(InEntity->GetName(), InEntity);
-    EntityList.Emplace(InEntity);
-    for (auto& tag : InEntity->Tags)
+    EntityList.MarkItemDirty(EntityList.Items.Emplace_GetRef(InEntity));
+
+    ARRBaseRobot* robot = Cast<ARRBaseRobot>(InEntity);
+    if (bReplicateRobotPoses && robot)
     {
-        if (EntitiesWithTag.Contains(tag))
-        {
-            EntitiesWithTag[tag].Actors.Emplace(InEntity);
-        }
-        else
-        {
-            FRREntities actors;
-            actors.Actors.Emplace(InEntity);
-            EntitiesWithTag.Emplace(tag, MoveTemp(actors));
-        }
+        // Robot poses are replicated fleet-wide by [RobotPoseList] instead
+        robot->SetReplicateMovement(false);
+        RobotPoseList.MarkItemDirty(RobotPoseList.Items.Emplace_GetRef(robot));
+    }
+
+    TArray<FName, TInlineAllocator<8>> tags;
+    for (const auto& tag : InEntity->Tags)
+    {
+        tags.AddUnique(tag);
+    }
+    for (const auto& tag : tags)
+    {
+        AddNewTaggedEntity(InEntity, tag);
     }
 }
 
 // Work around to replicating Entities and EntitiesWithTag since TMaps cannot be replicated
-void ASimulationState::OnRep_EntityList()
+void ASimulationState::ClientAddEntity(AActor* InEntity)
 {
-    for (AActor* entity : EntityList)
+    if (false == IsValid(InEntity) || RegisteredEntities.Contains(InEntity))
     {
-        if (false == IsValid(entity))
-        {
-            continue;
-        }
+        return;
+    }
+    RegisteredEntities.Add(InEntity);
+
+    UROS2Spawnable* entitySpawnParam = InEntity->FindComponentByClass<UROS2Spawnable>();
+    const FString entityName = entitySpawnParam ? entitySpawnParam->GetName() : InEntity->GetName();
+    if (false == Entities.Contains(entityName))
+    {
+        Entities.Emplace(entityName, InEntity);
+    }
 
-        if (!Entities.Contains(entity->GetName()))
+    TArray<FName, TInlineAllocator<8>> tags;
+    for (const auto& tag : InEntity->Tags)
+    {
+        tags.AddUnique(tag);
+    }
+    if (entitySpawnParam)
+    {
+        InEntity->Rename(*entityName);
+        for (const auto& tag : entitySpawnParam->ActorTags)
         {
-            UROS2Spawnable* rosSpawnParameters = entity->FindComponentByClass<UROS2Spawnable>();
-            if (rosSpawnParameters)
-            {
-                Entities.Emplace(rosSpawnParameters->GetName(), entity);
-            }
-            else
-            {
-                Entities.Emplace(entity->GetName(), entity);
-            }
+            tags.AddUnique(FName(tag));
         }
+    }
+    for (const auto& tag : tags)
+    {
+        AddNewTaggedEntity(InEntity, tag);
+    }
+}
+
+void ASimulationState::RemoveEntity(AActor* InEntity)
+{
+    if ((nullptr == InEntity) || (0 == RegisteredEntities.Remove(InEntity)))
+    {
+        return;
+    }
+
+    // Entities are keyed by their name, which is also their ROS 2 spawnable name if any, since they are renamed accordingly
+    const FString entityName = InEntity->GetName();
+    if (Entities.FindRef(entityName) == InEntity)
+    {
+        Entities.Remove(entityName);
+    }
 
-        for (const auto& tag : entity->Tags)
+    TArray<FName, TInlineAllocator<8>> tags(InEntity->Tags);
+    UROS2Spawnable* entitySpawnParam = InEntity->FindComponentByClass<UROS2Spawnable>();
+    if (entitySpawnParam)
+    {
+        for (const auto& tag : entitySpawnParam->ActorTags)
         {
-            AddTaggedEntity(entity, tag);
+            tags.AddUnique(FName(tag));
         }
-
-        UROS2Spawnable* EntitySpawnParam = entity->FindComponentByClass<UROS2Spawnable>();
-        if (EntitySpawnParam)
+    }
+    for (const auto& tag : tags)
+    {
+        FRREntities* taggedEntities = EntitiesWithTag.Find(tag);
+        if (taggedEntities)
         {
-            entity->Rename(*EntitySpawnParam->GetName());
-            for (const auto& tag : EntitySpawnParam->ActorTags)
+            taggedEntities->Actors.RemoveSingleSwap(InEntity);
+            if (0 == taggedEntities->Actors.Num())
             {
-                AddTaggedEntity(entity, FName(tag));
+                EntitiesWithTag.Remove(tag);
             }
         }
     }
 }
 
-void ASimulationState::OnRep_SpawnableEntityInfoList()
+TArray<AActor*> ASimulationState::GetEntityList() const
 {
-    for (const auto& entityInfo : SpawnableEntityInfoList)
+    TArray<AActor*> entities;
+    entities.Reserve(EntityList.Items.Num());
+    for (const auto& item : EntityList.Items)
     {
-        SpawnableEntityTypes.Emplace(entityInfo.EntityTypeName, entityInfo.EntityClass);
+        entities.Emplace(item.Entity);
     }
+    return entities;
 }
 
-void ASimulationState::AddTaggedEntity(AActor* Entity, const FName& InTag)
+void ASimulationState::AddNewTaggedEntity(AActor* InEntity, const FName& InTag)
 {
-    if (EntitiesWithTag.Contains(InTag))
-    {
-        // Check if Actor in EntitiesWithTag
+    EntitiesWithTag.FindOrAdd(InTag).Actors.Emplace(InEntity);
+}
 
-        bool ToEmplace = true;
-        for (AActor* TaggedActor : EntitiesWithTag[InTag].Actors)
-        {
-            if (TaggedActor->GetName() == Entity->GetName())
-            {
-                ToEmplace = false;
-            }
-        }
-        if (ToEmplace)
-        {
-            EntitiesWithTag[InTag].Actors.Emplace(Entity);
-        }
-    }
-    else
+void ASimulationState::AddTaggedEntity(AActor* Entity, const FName& InTag)
+{
+    FRREntities& taggedEntities = EntitiesWithTag.FindOrAdd(InTag);
+    if (false == taggedEntities.Actors.Contains(Entity))
     {
-        FRREntities actors;
-        actors.Actors.Emplace(Entity);
-        EntitiesWithTag.Emplace(InTag, actors);
+        taggedEntities.Actors.Emplace(Entity);
     }
 }
 
@@ -184,7 +414,22 @@ void ASimulationState::AddSpawnableEntityTypes(TMap<FString, TSubclassOf<AActor>
 {
     for (auto& elem : InSpawnableEntityTypes)
     {
-        SpawnableEntityInfoList.Emplace(FRREntityInfo(elem));
+        if (ReplicatedEntityTypeNames.Contains(elem.Key))
+        {
+            // Only an already replicated type whose class has changed is to be marked dirty
+            FRREntityInfo* entityInfo = SpawnableEntityInfoList.Items.FindByPredicate(
+                [&elem](const FRREntityInfo& InEntityInfo) { return InEntityInfo.EntityTypeName == elem.Key; });
+            if (entityInfo && (entityInfo->EntityClass != elem.Value))
+            {
+                entityInfo->EntityClass = elem.Value;
+                SpawnableEntityInfoList.MarkItemDirty(*entityInfo);
+            }
+        }
+        else
+        {
+            ReplicatedEntityTypeNames.Add(elem.Key);
+            SpawnableEntityInfoList.MarkItemDirty(SpawnableEntityInfoList.Items.Emplace_GetRef(FRREntityInfo(elem)));
+        }
         SpawnableEntityTypes.Emplace(MoveTemp(elem.Key), MoveTemp(elem.Value));
     }
 }
@@ -193,9 +438,14 @@ void ASimulationState::GetSpawnableEntityInfoList()
 {
     for (auto& elem : SpawnableEntityTypes)
     {
-        SpawnableEntityInfoList.Emplace(FRREntityInfo(elem));
+        bool bIsAlreadyReplicated = false;
+        ReplicatedEntityTypeNames.Add(elem.Key, &bIsAlreadyReplicated);
+        if (false == bIsAlreadyReplicated)
+        {
+            SpawnableEntityInfoList.MarkItemDirty(SpawnableEntityInfoList.Items.Emplace_GetRef(FRREntityInfo(elem)));
+        }
     }
-    if (SpawnableEntityInfoList.Num() > 0)
+    if (SpawnableEntityInfoList.Items.Num() > 0)
     {
         GetWorld()->GetTimerManager().ClearTimer(FetchEntityListTimerHandle);
     }
@@ -239,6 +489,46 @@ void ASimulationState::ServerSetEntityState(const FROSSetEntityStateReq& InReque
     PrevSetEntityStateRequest = InRequest;
 }
 
+bool ASimulationState::ServerSaveCheckpoint()
+{
+    if (false == VerifyIsServerCall(TEXT("ServerSaveCheckpoint")))
+    {
+        return false;
+    }
+
+    const bool bResult = Checkpoint.Capture(GetWorld(), Entities);
+    UE_LOG_WITH_INFO(LogRapyutaCore,
+                     Log,
+                     TEXT("Saved checkpoint of %d entities at %.3f s, %d bytes"),
+                     Checkpoint.EntityNum,
+                     Checkpoint.TimeSeconds,
+                     Checkpoint.Data.Num());
+    return bResult;
+}
+
+int32 ASimulationState::ServerRestoreCheckpoint(const bool bInRestoreClock)
+{
+    if (false == VerifyIsServerCall(TEXT("ServerRestoreCheckpoint")))
+    {
+        return INDEX_NONE;
+    }
+
+    if (false == Checkpoint.IsValid())
+    {
+        UE_LOG_WITH_INFO(LogRapyutaCore, Warning, TEXT("No checkpoint saved yet"));
+        return INDEX_NONE;
+    }
+    const int32 restoredNum = Checkpoint.Restore(GetWorld(), Entities, bInRestoreClock);
+    UE_LOG_WITH_INFO(LogRapyutaCore, Log, TEXT("Restored %d/%d entities from checkpoint"), restoredNum, Checkpoint.EntityNum);
+
+    // Replicate restored poses right away
+    if (bReplicateRobotPoses)
+    {
+        ServerUpdateRobotPoses();
+    }
+    return restoredNum;
+}
+
 bool ASimulationState::ServerCheckAttachRequest(const FROSAttachReq& InRequest)
 {
     if (false == VerifyIsServerCall(TEXT("ServerCheckAttachRequest")))
@@ -482,8 +772,26 @@ void ASimulationState::ServerDeleteEntity(const FROSDeleteEntityReq& InRequest)
 
     if (ServerCheckDeleteRequest(InRequest))
     {
-        AActor* Removed = Entities.FindAndRemoveChecked(InRequest.Name);
-        Removed->Destroy();
+        AActor* removed = Entities.FindChecked(InRequest.Name);
+        RemoveEntity(removed);
+        Entities.Remove(InRequest.Name);
+
+        // Only the removal is delta-replicated to clients, which then unregister [removed] on their side
+        const int32 itemIndex =
+            EntityList.Items.IndexOfByPredicate([removed](const FRREntityListItem& InItem) { return InItem.Entity == removed; });
+        if (INDEX_NONE != itemIndex)
+        {
+            EntityList.Items.RemoveAtSwap(itemIndex);
+            EntityList.MarkArrayDirty();
+        }
+        const int32 poseItemIndex =
+            RobotPoseList.Items.IndexOfByPredicate([removed](const FRRRobotPoseItem& InItem) { return InItem.Robot == removed; });
+        if (INDEX_NONE != poseItemIndex)
+        {
+            RobotPoseList.Items.RemoveAtSwap(poseItemIndex);
+            RobotPoseList.MarkArrayDirty();
+        }
+        removed->Destroy();
     }
     PrevDeleteEntityRequest = InRequest;
 }
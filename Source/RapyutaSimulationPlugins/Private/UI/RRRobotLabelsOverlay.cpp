@@ -0,0 +1,161 @@
+// Copyright 2020-2023 Rapyuta Robotics Co., Ltd.
+#include "UI/RRRobotLabelsOverlay.h"
+
+// UE
+#include "CanvasItem.h"
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/Font.h"
+#include "SceneView.h"
+
+void URRRobotLabelsOverlay::Initialize(FSubsystemCollectionBase& InCollection)
+{
+    Super::Initialize(InCollection);
+    Font = GEngine ? GEngine->GetSmallFont() : nullptr;
+    DrawHandle =
+        UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &URRRobotLabelsOverlay::DrawLabels));
+}
+
+void URRRobotLabelsOverlay::Deinitialize()
+{
+    UDebugDrawService::Unregister(DrawHandle);
+    DrawHandle.Reset();
+    Labels.Empty();
+    LabelIndices.Empty();
+    Super::Deinitialize();
+}
+
+void URRRobotLabelsOverlay::AddLabel(AActor* InActor, const FString& InText, const FVector& InOffset)
+{
+    if (nullptr == InActor)
+    {
+        return;
+    }
+    FRRRobotLabel* label = FindLabel(InActor);
+    if (nullptr == label)
+    {
+        LabelIndices.Add(InActor, Labels.Num());
+        label = &Labels.AddDefaulted_GetRef();
+        label->Actor = InActor;
+        InActor->OnEndPlay.AddUniqueDynamic(this, &URRRobotLabelsOverlay::OnLabelActorEndPlay);
+    }
+    label->Offset = InOffset;
+    label->Text = FText::FromString(InText);
+    label->bTextSizeDirty = true;
+}
+
+void URRRobotLabelsOverlay::RemoveLabel(const AActor* InActor)
+{
+    int32 labelIndex = INDEX_NONE;
+    if (false == LabelIndices.RemoveAndCopyValue(InActor, labelIndex))
+    {
+        return;
+    }
+    Labels.RemoveAtSwap(labelIndex);
+    if (Labels.IsValidIndex(labelIndex))
+    {
+        // Re-index the label swapped into the removed one's slot, labels being removed upon their actor's end play
+        if (int32* movedLabelIndex = LabelIndices.Find(Labels[labelIndex].Actor.Get(true)))
+        {
+            *movedLabelIndex = labelIndex;
+        }
+    }
+}
+
+void URRRobotLabelsOverlay::SetLabelText(const AActor* InActor, const FString& InText)
+{
+    if (FRRRobotLabel* label = FindLabel(InActor))
+    {
+        if (false == label->Text.ToString().Equals(InText, ESearchCase::CaseSensitive))
+        {
+            label->Text = FText::FromString(InText);
+            label->bTextSizeDirty = true;
+        }
+    }
+}
+
+void URRRobotLabelsOverlay::SetLabelTextVisible(const AActor* InActor, bool bInTextVisible)
+{
+    if (FRRRobotLabel* label = FindLabel(InActor))
+    {
+        label->bTextVisible = bInTextVisible;
+    }
+}
+
+void URRRobotLabelsOverlay::SetLabelVisible(const AActor* InActor, bool bInVisible)
+{
+    if (FRRRobotLabel* label = FindLabel(InActor))
+    {
+        label->bVisible = bInVisible;
+    }
+}
+
+void URRRobotLabelsOverlay::OnLabelActorEndPlay(AActor* InActor, EEndPlayReason::Type InEndPlayReason)
+{
+    RemoveLabel(InActor);
+}
+
+FRRRobotLabel* URRRobotLabelsOverlay::FindLabel(const AActor* InActor)
+{
+    const int32* labelIndex = LabelIndices.Find(InActor);
+    return labelIndex ? &Labels[*labelIndex] : nullptr;
+}
+
+void URRRobotLabelsOverlay::DrawLabels(UCanvas* InCanvas, APlayerController* InPlayerController)
+{
+    // [UDebugDrawService] is shared by all worlds' viewports
+    UWorld* world = GetWorld();
+    if ((0 == Labels.Num()) || (nullptr == InCanvas) || (nullptr == InCanvas->SceneView) || (nullptr == Font) ||
+        (nullptr == world) || (InCanvas->SceneView->Family->Scene != world->Scene))
+    {
+        return;
+    }
+
+    const FMatrix viewProjectionMatrix = InCanvas->SceneView->ViewMatrices.GetViewProjectionMatrix();
+    const FVector viewOrigin = InCanvas->SceneView->ViewMatrices.GetViewOrigin();
+    const float maxDistanceSquared = (MaxLabelDistance > 0.f) ? FMath::Square(MaxLabelDistance) : MAX_flt;
+    const FVector2D screenSize(InCanvas->ClipX, InCanvas->ClipY);
+
+    FCanvasTextItem textItem(FVector2D::ZeroVector, FText::GetEmpty(), Font, TextColor);
+    textItem.EnableShadow(FLinearColor::Black);
+    for (auto& label : Labels)
+    {
+        const AActor* actor = label.Actor.Get();
+        if ((nullptr == actor) || (false == label.bVisible) || (false == label.bTextVisible) || label.Text.IsEmpty())
+        {
+            continue;
+        }
+
+        // Distance & frustum culling
+        const FVector labelLocation = actor->GetActorLocation() + label.Offset;
+        if (FVector::DistSquared(labelLocation, viewOrigin) > maxDistanceSquared)
+        {
+            continue;
+        }
+        const FVector4 clipLocation = viewProjectionMatrix.TransformFVector4(FVector4(labelLocation, 1.f));
+        if (clipLocation.W <= UE_KINDA_SMALL_NUMBER)
+        {
+            continue;
+        }
+        const FVector2D ndcLocation(clipLocation.X / clipLocation.W, clipLocation.Y / clipLocation.W);
+        if ((FMath::Abs(ndcLocation.X) > 1.f) || (FMath::Abs(ndcLocation.Y) > 1.f))
+        {
+            continue;
+        }
+
+        // Re-layout only upon text change
+        if (label.bTextSizeDirty)
+        {
+            float textWidth = 0.f, textHeight = 0.f;
+            InCanvas->TextSize(Font, label.Text.ToString(), textWidth, textHeight);
+            label.TextSize = FVector2D(textWidth, textHeight);
+            label.bTextSizeDirty = false;
+        }
+
+        const FVector2D screenLocation(0.5f * (ndcLocation.X + 1.f) * screenSize.X, 0.5f * (1.f - ndcLocation.Y) * screenSize.Y);
+        textItem.Position = screenLocation - 0.5f * label.TextSize;
+        textItem.Text = label.Text;
+        InCanvas->DrawItem(textItem);
+    }
+}
@@ -23,6 +23,7 @@
 #include "logUtilities.h"
 
 // RapyutaSimulationPlugins
+#include "Core/RRJobGraph.h"
 #include "RapyutaSimulationPlugins.h"
 
 #include "RRActorCommon.generated.h"
@@ -124,127 +125,87 @@ struct RAPYUTASIMULATIONPLUGINS_API FRRStreamingLevelInfo
 };
 
 /**
- * @brief Async job info (task, job name, latest capture batch id)
- * This struct contains TFuture, which has private ctor, thus is move-only and could not be a USTRUCT().
- * and also make itself by default non-copyable without custom copy ctor!
+ * @brief Async job info (tasks, job name, latest capture batch id), whose tasks are launched through #FRRJobGraph.
+ * Tasks are grouped into capture batches, each with its completion task created by #CloseBatch, thus there is no need to
+ * poll per-task done flags.
  */
 struct RAPYUTASIMULATIONPLUGINS_API FRRAsyncJob
 {
-    template<typename TResult>
-    struct RAPYUTASIMULATIONPLUGINS_API FRRSingleAsyncTask
+    explicit FRRAsyncJob(const FString& InJobName, const FName& InCategory = NAME_None)
+        : JobName(InJobName), Category(InCategory)
     {
-        //! [TSharedFuture] should be considered if [Task] is accessed from multiple threads!
-        TFuture<TResult> Task;
-
-        bool DoneStatus = false;
-
-        FRRSingleAsyncTask()
-        {
-        }
-
-        //! TFuture is move-only, only exposing a move-ctor
-        FRRSingleAsyncTask(TFuture<TResult>&& InAsyncTask) : Task(MoveTemp(InAsyncTask))
-        {
-        }
-
-        //! TFuture is move-only, thus this is to facilitate this class' Move operation!
-        FRRSingleAsyncTask(FRRSingleAsyncTask&& Other)
-        {
-            *this = MoveTemp(Other);
-        }
-
-        FRRSingleAsyncTask& operator=(FRRSingleAsyncTask&& Other)
-        {
-            Task = MoveTemp(Other.Task);
-            Other.Task.Reset();
-
-            DoneStatus = Other.DoneStatus;
-            Other.DoneStatus = false;
-            return *this;
-        }
-    };
-
-    explicit FRRAsyncJob(const FString& InJobName) : JobName(InJobName)
-    {
-    }
-    FRRAsyncJob(FRRAsyncJob&& Other)
-    {
-        verify(AsyncTasks.Num() == Other.AsyncTasks.Num());
-        for (int32 i = 0; i < AsyncTasks.Num(); ++i)
-        {
-            // This [MoveTemp] would help invoke [FRRSingleAsyncTask] move-ctor!
-            AsyncTasks[i] = MoveTemp(Other.AsyncTasks[i]);
-        }
-        Other.AsyncTasks.Empty();
     }
 
-    static constexpr const int8 TASK_INDEX_NONE = -1;
-
     FString JobName;
 
+    //! #FRRJobGraph category, of which the concurrency limit applies to this job's tasks
+    FName Category = NAME_None;
+
     //! This stores the up-to-the-moment capture batch id every time an async task is added to be scheduled for running!
     uint64 LatestCaptureBatchId = 0;
 
-    TArray<FRRSingleAsyncTask<bool>> AsyncTasks;
+    //! Shared by all tasks of this job, recreated by #Clear
+    FRRJobCancellationTokenRef CancellationToken = MakeShared<FRRJobCancellationToken, ESPMode::ThreadSafe>();
+
+    TArray<UE::Tasks::FTask> AsyncTasks;
 
-    // For the future of UE C++
-    // TFunction<void(ArgTypes&&...Args)> OnTaskDone;
+    //! Tasks of batches not yet closed by #CloseBatch
+    TMap<uint64, TArray<UE::Tasks::FTask>> OpenBatchTasks;
 
     int32 GetTasksNum() const
     {
         return AsyncTasks.Num();
     }
 
-    //! TFuture is move-only!
-    void SetAsyncTaskAtLast(TFuture<bool>&& InAsyncTask)
+    void AddAsyncTask(const uint64 InCaptureBatchId, const UE::Tasks::FTask& InAsyncTask)
     {
-        verify(AsyncTasks.Num());
-        AsyncTasks.Last().Task = MoveTemp(InAsyncTask);
+        LatestCaptureBatchId = InCaptureBatchId;
+        AsyncTasks.Add(InAsyncTask);
+        OpenBatchTasks.FindOrAdd(InCaptureBatchId).Add(InAsyncTask);
     }
 
-    void AddAsyncTask(const uint64 InCaptureBatchId, TFuture<bool>&& InAsyncTask)
+    /**
+     * @brief Close a capture batch to which no more task is added
+     * @param InCaptureBatchId
+     * @param InOnBatchCompleted Optional, run in a worker thread once all the batch's tasks have completed
+     * @return Batch completion task, which could be waited on or be a prerequisite of other tasks
+     */
+    UE::Tasks::FTask CloseBatch(const uint64 InCaptureBatchId, TUniqueFunction<void()> InOnBatchCompleted = nullptr)
     {
-        LatestCaptureBatchId = InCaptureBatchId;
-        AsyncTasks.Emplace(MoveTemp(InAsyncTask));
+        TArray<UE::Tasks::FTask> batchTasks;
+        OpenBatchTasks.RemoveAndCopyValue(InCaptureBatchId, batchTasks);
+        return UE::Tasks::Launch(
+            TEXT("FRRAsyncJob::CloseBatch"),
+            [InOnBatchCompleted = MoveTemp(InOnBatchCompleted)]()
+            {
+                if (InOnBatchCompleted)
+                {
+                    InOnBatchCompleted();
+                }
+            },
+            batchTasks);
     }
 
-    void AddDefaultAsyncTask()
+    //! Skip this job's tasks not yet started, running ones could poll #CancellationToken
+    void Cancel()
     {
-        AsyncTasks.Emplace(FRRSingleAsyncTask<bool>());
+        CancellationToken->Cancel();
     }
 
+    //! Forget all tasks, which keep running. Tasks added afterwards are not affected by a previous #Cancel.
     void Clear()
     {
         AsyncTasks.Reset();
+        OpenBatchTasks.Reset();
         LatestCaptureBatchId = 0;
-    }
-
-    void MarkSingleTaskAsDone(int32 TaskIndex, const FString& TaskName)
-    {
-        if (TASK_INDEX_NONE == TaskIndex)
-        {
-            return;
-        }
-
-        if (AsyncTasks.IsValidIndex(TaskIndex))
-        {
-            AsyncTasks[TaskIndex].DoneStatus = true;
-#if RAPYUTA_SIM_DEBUG
-            UE_LOG_WITH_INFO(LogTemp, Display, TEXT("[%s] Async Task done [%d]/[%d]!"), *TaskName, (TaskIndex + 1), GetTasksNum());
-#endif
-        }
-        else
-        {
-            UE_LOG_WITH_INFO(
-                LogTemp, Error, TEXT("[%s] FRRAsyncJob Invalid Async Task Index: %d/%d"), *TaskName, TaskIndex, GetTasksNum());
-        }
+        CancellationToken = MakeShared<FRRJobCancellationToken, ESPMode::ThreadSafe>();
     }
 
     bool IsDone() const
     {
         for (const auto& asyncTask : AsyncTasks)
         {
-            if (!asyncTask.DoneStatus)
+            if (false == asyncTask.IsCompleted())
             {
                 return false;
             }
@@ -254,10 +215,7 @@ struct RAPYUTASIMULATIONPLUGINS_API FRRAsyncJob
 
     void WaitUntilCompleted()
     {
-        for (const auto& asyncTask : AsyncTasks)
-        {
-            asyncTask.Task.Get();
-        }
+        UE::Tasks::Wait(AsyncTasks);
     }
 };
 
@@ -372,6 +330,101 @@ struct RAPYUTASIMULATIONPLUGINS_API FRREntityLogInfo
     TArray<FVector2D> BBVertices2D;
 };
 
+/**
+ * @brief Visibility flags of an entity's projected bounding box, output by #URRUObjectUtils::ProjectEntityHulls
+ */
+UENUM(meta = (Bitflags))
+enum class ERRProjectedBoxFlags : uint8
+{
+    NONE = 0x00,
+    //! At least part of the hull is in front of the camera & inside the image
+    VISIBLE = 0x01,
+    //! The 2D box has been clipped by the image borders, or some hull points are behind the camera
+    TRUNCATED = 0x02,
+    //! The line of sight from the camera to the hull center is blocked, set by #URRUObjectUtils::CheckEntityHullsOcclusion
+    OCCLUDED = 0x04
+};
+ENUM_CLASS_FLAGS(ERRProjectedBoxFlags);
+
+/**
+ * @brief Contiguous local-space hull points of a batch of entities, to be projected by #URRUObjectUtils::ProjectEntityHulls.
+ * Hull points are cached once per entity (eg its 8 local bounding box vertices), then only #EntityTransforms need updating
+ * per frame.
+ */
+struct RAPYUTASIMULATIONPLUGINS_API FRREntityHulls
+{
+    //! Hull points of all entities, each in its entity's local space, laid out contiguously entity by entity
+    TArray<FVector3f> LocalHullPoints;
+
+    //! [i]-th entity's hull points are [HullPointOffsets[i], HullPointOffsets[i + 1]) of #LocalHullPoints
+    TArray<int32> HullPointOffsets = {0};
+
+    //! World transform of each entity
+    TArray<FTransform> EntityTransforms;
+
+    int32 GetEntitiesNum() const
+    {
+        return EntityTransforms.Num();
+    }
+
+    void Reset()
+    {
+        LocalHullPoints.Reset();
+        HullPointOffsets.Reset();
+        HullPointOffsets.Add(0);
+        EntityTransforms.Reset();
+    }
+
+    /**
+     * @brief Append an entity's hull
+     * @param InLocalHullPoints
+     * @param InEntityTransform
+     * @return Index of the new entity
+     */
+    int32 AddEntity(const TArray<FVector3f>& InLocalHullPoints, const FTransform& InEntityTransform)
+    {
+        LocalHullPoints.Append(InLocalHullPoints);
+        HullPointOffsets.Add(LocalHullPoints.Num());
+        return EntityTransforms.Add(InEntityTransform);
+    }
+};
+
+/**
+ * @brief Structure-of-arrays output of #URRUObjectUtils::ProjectEntityHulls, one element per entity.
+ * Kept across frames by the caller so that its buffers are reused without reallocation.
+ */
+struct RAPYUTASIMULATIONPLUGINS_API FRRProjectedBoundingBoxes
+{
+    //! 2D box min corners in pixels, clipped to the image
+    TArray<FVector2f> BoxMins;
+
+    //! 2D box max corners in pixels, clipped to the image
+    TArray<FVector2f> BoxMaxs;
+
+    //! Nearest view depth of the hull points in front of the camera [cm]
+    TArray<float> MinDepths;
+
+    //! Hull center in world space
+    TArray<FVector> WorldCenters;
+
+    //! #ERRProjectedBoxFlags of each entity
+    TArray<ERRProjectedBoxFlags> Flags;
+
+    void SetNum(const int32 InEntitiesNum)
+    {
+        BoxMins.SetNumUninitialized(InEntitiesNum, false);
+        BoxMaxs.SetNumUninitialized(InEntitiesNum, false);
+        MinDepths.SetNumUninitialized(InEntitiesNum, false);
+        WorldCenters.SetNumUninitialized(InEntitiesNum, false);
+        Flags.SetNumUninitialized(InEntitiesNum, false);
+    }
+
+    bool IsVisible(const int32 InEntityIndex) const
+    {
+        return EnumHasAnyFlags(Flags[InEntityIndex], ERRProjectedBoxFlags::VISIBLE);
+    }
+};
+
 template<int8 InBitDepth>
 using FRRColor = typename TChooseClass<(8 == InBitDepth),
                                        FColor,
@@ -725,6 +778,56 @@ public:
         } while (StaticCustomDepthStencilList.Contains(LatestCustomDepthStencilValue));
         return LatestCustomDepthStencilValue;
     }
+
+    // NOTE:
+    // + Beyond the 8-bit custom depth stencil, instance ids are 24-bit, set per primitive as 3 byte-valued floats into
+    // CustomPrimitiveData[INSTANCE_ID_CUSTOM_PRIMITIVE_DATA_INDEX, +2], which are rendered by #URRInstanceIdCaptureComponent.
+    // + Ids are kept by their entities for their whole lifetime, regardless of activation, thus the id->entity table stays
+    // valid for annotating captures. Ids of ended entities are reused.
+    static constexpr int32 INSTANCE_ID_CUSTOM_PRIMITIVE_DATA_INDEX = 0;
+    static constexpr uint32 INSTANCE_ID_VOID = 0;
+    static constexpr uint32 MAX_INSTANCE_ID = 0xFFFFFF;
+
+    UPROPERTY()
+    uint32 LatestInstanceId = INSTANCE_ID_VOID;
+
+    //! Ids unregistered by their ended entities, to be reused first
+    TArray<uint32> FreeInstanceIds;
+
+    //! Id->entity table, only modified through #RegisterInstanceIdEntity & #UnregisterInstanceIdEntity
+    TMap<uint32, TWeakObjectPtr<ARRMeshActor>> InstanceIdEntityTable;
+
+    /**
+     * @brief Register a mesh actor to #InstanceIdEntityTable with a unique instance id, a freed one if any or a new one
+     * @param InEntity
+     * @return #INSTANCE_ID_VOID if all ids are in use
+     */
+    uint32 RegisterInstanceIdEntity(ARRMeshActor* InEntity);
+
+    /**
+     * @brief Unregister a mesh actor from #InstanceIdEntityTable, freeing its instance id for reuse
+     * @param InInstanceId
+     * @param InEntity Only unregistered if it is the one registered with InInstanceId
+     */
+    void UnregisterInstanceIdEntity(uint32 InInstanceId, const ARRMeshActor* InEntity);
+
+    ARRMeshActor* GetEntityByInstanceId(uint32 InInstanceId) const;
+
+    //! Encode an instance id as normalized RGB bytes, as set into CustomPrimitiveData & output by the instance id material
+    static FLinearColor EncodeInstanceId(uint32 InInstanceId)
+    {
+        return FLinearColor(static_cast<float>(InInstanceId & 0xFF) / 255.f,
+                            static_cast<float>((InInstanceId >> 8) & 0xFF) / 255.f,
+                            static_cast<float>((InInstanceId >> 16) & 0xFF) / 255.f,
+                            1.f);
+    }
+
+    //! Decode an instance id from a pixel of a 32-bit float capture
+    static uint32 DecodeInstanceId(const FLinearColor& InColor)
+    {
+        auto toByte = [](float InValue) { return static_cast<uint32>(FMath::Clamp(FMath::RoundToInt(InValue * 255.f), 0, 255)); };
+        return toByte(InColor.R) | (toByte(InColor.G) << 8) | (toByte(InColor.B) << 16);
+    }
 };
 
 class ARRSceneDirector;
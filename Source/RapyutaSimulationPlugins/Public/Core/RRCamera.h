@@ -113,6 +113,13 @@ public:
         return FVector::Dist(CameraComponent->GetComponentLocation(), URRUObjectUtils::GetActorGroupListCenter(InActorGroups));
     }
 
+    /**
+     * @brief Get the current world->clip matrix of #CameraComponent, eg for #URRUObjectUtils::ProjectEntityHulls
+     * @param InImageSize Image size in pixels, overriding #UCameraComponent::AspectRatio if valid
+     * @return FMatrix
+     */
+    FMatrix GetViewProjectionMatrix(const FIntPoint& InImageSize = FIntPoint::ZeroValue) const;
+
     float GetFocalLength() const
     {
         // HFOV = 2 * arctan( width / 2f )
@@ -602,19 +602,93 @@ public:
         return loadedTexture;
     }
 
+    /**
+     * @brief Load all images of given types inside a folder into textures.
+     * File reading & decompression are done in parallel on worker threads, in batches to bound the decoded memory in flight,
+     * leaving only texture creation on the calling (game) thread.
+     * Decoded pixels are cached on disk in #GetImageCacheFolderPath() if #SImageCacheEnabled, keyed by file content hash,
+     * so that next loads of the same images skip decompression.
+     * Images which are not 8-bit (eg 16-bit PNG, EXR) are loaded by #LoadImageToTexture instead, keeping their precision.
+     * @param InImageFolderPath
+     * @param InImageFileTypes
+     * @param OutImageTextureList
+     * @param bIsLogged
+     * @return true if all images have been loaded
+     */
     static bool LoadImagesFromFolder(const FString& InImageFolderPath,
                                      const TArray<ERRFileType>& InImageFileTypes,
                                      TArray<UTexture*>& OutImageTextureList,
                                      bool bIsLogged = false);
 
-    static FRRLightProfileData SLightProfileData;
+    //! Whether decoded images are cached on disk by #LoadImagesFromFolder
+    static bool SImageCacheEnabled;
+    static constexpr const TCHAR* IMAGE_CACHE_FOLDER_NAME = TEXT("RRImageCache");
+    static constexpr uint32 IMAGE_CACHE_FILE_MAGIC = 0x52524943;    // RRIC
+    static FString GetImageCacheFolderPath()
+    {
+        return FPaths::ProjectSavedDir() / IMAGE_CACHE_FOLDER_NAME;
+    }
+
+    /**
+     * @brief Read & decode an 8-bit image file into BGRA pixels, using the on-disk cache if enabled. Thread-safe,
+     * given #LoadImageWrapperModule() has been called beforehand on game thread.
+     * Cache entries whose pixel data size does not match their header are ignored & overwritten.
+     * @param InFullFilePath
+     * @param OutImageData
+     * @return true if succeeded, false if failed or the image is not 8-bit
+     */
+    static bool DecodeImageFile(const FString& InFullFilePath, FRRDecodedImageData& OutImageData);
+
+    /**
+     * @brief Create a transient texture from decoded image data. Must be called on game thread.
+     * @param InImageData
+     * @param InTextureName
+     * @return UTexture2D*
+     */
+    static UTexture2D* CreateTextureFromImageData(const FRRDecodedImageData& InImageData, const FString& InTextureName);
+
+    //! Parsed IES profiles & their light profiles, keyed by IES file path. Only accessed on game thread.
+    static TMap<FString, FRRCachedLightProfile> SLightProfileCache;
+
+    /**
+     * @brief Read & parse an IES file into light profile texture data. Thread-safe.
+     * @param InFullFilePath
+     * @param OutLightProfileData
+     * @return true if succeeded
+     */
+    static bool ParseIESProfile(const FString& InFullFilePath, FRRLightProfileData& OutLightProfileData);
+
+    /**
+     * @brief Create a transient light profile texture from parsed data. Must be called on game thread.
+     * @param InLightProfileData
+     * @param InLightProfileName
+     * @return UTextureLightProfile*
+     */
+    static UTextureLightProfile* CreateLightProfile(const FRRLightProfileData& InLightProfileData,
+                                                    const FString& InLightProfileName);
+
+    /**
+     * @brief Load an IES file into a light profile texture, reusing #SLightProfileCache's light profile or parsed data
+     * if the file has not been modified since.
+     * @param InFullFilePath
+     * @param InLightProfileName
+     * @return UTextureLightProfile*
+     */
     static UTextureLightProfile* LoadIESProfile(const FString& InFullFilePath, const FString& InLightProfileName);
+
+    /**
+     * @brief Load all IES files inside a folder into light profile textures.
+     * Files not yet in #SLightProfileCache or modified since are parsed in parallel on worker threads, then light profiles
+     * are created on the calling (game) thread by #LoadIESProfile.
+     * @param InFolderPath
+     * @param OutLightProfileList
+     * @param bIsLogged
+     * @return true if all IES files have been loaded
+     */
     static bool LoadIESProfilesFromFolder(const FString& InFolderPath,
                                           TArray<UTextureLightProfile*>& OutLightProfileList,
                                           bool bIsLogged = false);
 
-    static TFunction<void(uint8*, const FUpdateTextureRegion2D*)> CleanupLightProfileData;
-
     static bool IsValidBitDepth(int32 InBitDepth)
     {
         return (URRActorCommon::IMAGE_BIT_DEPTH_INT8 == InBitDepth) || (URRActorCommon::IMAGE_BIT_DEPTH_FLOAT16 == InBitDepth) ||
@@ -20,9 +20,16 @@ class RAPYUTASIMULATIONPLUGINS_API ARRCrowdROSController : public ARRCrowdAICont
 {
     GENERATED_BODY()
 
+public:
+    //! If true, the possessed pawn is registered to #URRCrowdSignificanceManager, which initializes its ROS 2 interface only
+    //! once it is among the agents nearest to observers, and reduces its movement detail otherwise.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bUseSignificanceLOD = false;
+
 protected:
     /**
-     * @brief Initialize robot pawn by calling #ARRBaseRobot::InitROS2Interface.
+     * @brief Initialize robot pawn by calling #ARRBaseRobot::InitROS2Interface,
+     * or register it to #URRCrowdSignificanceManager if #bUseSignificanceLOD.
      *
      * @sa [OnPossess](https://docs.unrealengine.com/5.1/en-US/API/Runtime/AIModule/AAIController/OnPossess/)
      * @param InPawn
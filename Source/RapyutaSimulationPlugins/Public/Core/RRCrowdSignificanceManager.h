@@ -0,0 +1,140 @@
+/**
+ * @file RRCrowdSignificanceManager.h
+ * @brief Significance-based ROS & tick LOD of crowd agents, ranked by distance to observers (robots, cameras)
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RRCrowdSignificanceManager.generated.h"
+
+class ARRBaseRobot;
+class URRRobotROS2Interface;
+
+/**
+ * @brief Significance state of a crowd agent registered to #URRCrowdSignificanceManager
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRRCrowdAgentSignificance
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TWeakObjectPtr<ARRBaseRobot> Agent = nullptr;
+
+    //! Kept since #URRRobotROS2Interface::DeInitialize resets the agent's own reference
+    UPROPERTY()
+    URRRobotROS2Interface* ROS2Interface = nullptr;
+
+    UPROPERTY()
+    bool bIsSignificant = false;
+
+    UPROPERTY()
+    bool bIsROS2InterfaceInitialized = false;
+
+    //! Squared distance to the nearest observer, as of the last update
+    UPROPERTY()
+    float DistanceSquared = 0.f;
+};
+
+/**
+ * @brief Significance manager of crowd agents, eg pedestrians possessed by #ARRCrowdROSController.
+ * Agents are ranked by distance to their nearest registered observer (robots, cameras) every #UpdateInterval. Only the
+ * #MaxSignificantAgentsNum nearest ones are significant, having:
+ * - Their ROS 2 interface initialized upon first promotion & publishing
+ * - Full tick rate & sweeping movement
+ * while insignificant ones have their publishers stopped, movement ticked every #InsignificantTickInterval & sweep-free on
+ * the navmesh (#URRFloatingMovementComponent::SetPlanarNavMeshMovement).
+ * Currently significant agents are ranked with their distance shrunk by #HysteresisRatio, so that agents around the
+ * significance boundary do not flicker between both states.
+ */
+UCLASS(config = RapyutaSimSettings)
+class RAPYUTASIMULATIONPLUGINS_API URRCrowdSignificanceManager : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //! Max number of significant agents
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    int32 MaxSignificantAgentsNum = 16;
+
+    //! >= 1, Ratio by which significant agents' distances are shrunk upon ranking
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float HysteresisRatio = 1.25f;
+
+    //! [sec] Interval of significance ranking
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float UpdateInterval = 0.5f;
+
+    //! [sec] Tick interval of insignificant agents' movement & path following components
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float InsignificantTickInterval = 0.2f;
+
+    UFUNCTION(BlueprintCallable)
+    void RegisterObserver(AActor* InObserver);
+
+    UFUNCTION(BlueprintCallable)
+    void UnregisterObserver(AActor* InObserver);
+
+    /**
+     * @brief Register a crowd agent, whose ROS 2 interface is then initialized by this manager upon its first promotion.
+     * It starts as insignificant until the next update.
+     * @param InAgent
+     */
+    UFUNCTION(BlueprintCallable)
+    void RegisterAgent(ARRBaseRobot* InAgent);
+
+    /**
+     * @brief Unregister a crowd agent, restoring its full tick rate & sweeping movement
+     * @param InAgent
+     */
+    UFUNCTION(BlueprintCallable)
+    void UnregisterAgent(ARRBaseRobot* InAgent);
+
+    UFUNCTION(BlueprintCallable)
+    bool IsAgentSignificant(const ARRBaseRobot* InAgent) const;
+
+    /**
+     * @brief Rank agents & promote/demote them
+     */
+    UFUNCTION(BlueprintCallable)
+    void UpdateSignificance();
+
+    virtual void Tick(float InDeltaTime) override;
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(URRCrowdSignificanceManager, STATGROUP_Tickables);
+    }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type InWorldType) const override
+    {
+        return (EWorldType::Game == InWorldType) || (EWorldType::PIE == InWorldType);
+    }
+
+    /**
+     * @brief Promote/Demote an agent
+     * @param InOutAgentSignificance
+     * @param bInIsSignificant
+     */
+    void SetAgentSignificant(FRRCrowdAgentSignificance& InOutAgentSignificance, bool bInIsSignificant);
+
+    /**
+     * @brief Set tick interval of an agent's movement & path following components, and whether it moves planar on the navmesh
+     * @param InAgent
+     * @param bInIsFullDetail
+     */
+    void SetAgentMovementDetail(ARRBaseRobot* InAgent, bool bInIsFullDetail);
+
+    UPROPERTY()
+    TArray<TWeakObjectPtr<AActor>> Observers;
+
+    UPROPERTY()
+    TArray<FRRCrowdAgentSignificance> Agents;
+
+    float TimeSinceLastUpdate = 0.f;
+};
@@ -0,0 +1,137 @@
+/**
+ * @file RRDatasetWriter.h
+ * @brief Asynchronous synthetic dataset writer of #FRRColorArray images & #FRREntityLogInfo annotations.
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "IImageWrapper.h"
+#include "Templates/SharedPointer.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRActorCommon.h"
+
+/**
+ * @brief A captured data frame, to be written by #FRRDatasetWriter
+ */
+struct RAPYUTASIMULATIONPLUGINS_API FRRDatasetFrame
+{
+public:
+    //! Image name without extension, relative to the shard folder
+    FString ImageName;
+
+    //! Output image file type, among PNG, JPG, grayscale JPG & EXR. NONE writes raw pixel bytes in .raw file.
+    ERRFileType ImageFileType = ERRFileType::IMAGE_PNG;
+
+    FIntPoint ImageSize = FIntPoint::ZeroValue;
+
+    //! 8, 16 or 32, selecting the #ImageData color array
+    int8 BitDepth = URRActorCommon::IMAGE_BIT_DEPTH_INT8;
+
+    FRRColorArray ImageData;
+
+    //! Annotations of the frame. Their [Entities] are not accessed by the writer.
+    TArray<FRREntityLogInfo> EntityLogInfos;
+};
+
+/**
+ * @brief Asynchronous synthetic dataset writer.
+ * Frames are encoded & written in parallel by thread pool workers, bounded by #MaxPendingFramesNum frames in flight:
+ * #EnqueueFrame rejects new frames while full, so that the capturer (eg #ARRSceneDirector) could back off instead of
+ * blocking the game thread on serialization.
+ * Output is sharded into [OutputFolderPath/shard_XXXXX/] folders of #FramesPerShard frames, each with its images and a
+ * line-delimited JSON annotation file [annotations.jsonl].
+ * Free disk space is checked periodically with #URRCoreUtils::HasEnoughDiskSpace.
+ */
+class RAPYUTASIMULATIONPLUGINS_API FRRDatasetWriter : public TSharedFromThis<FRRDatasetWriter, ESPMode::ThreadSafe>
+{
+public:
+    /**
+     * @brief Construct a new FRRDatasetWriter. Must be done on game thread.
+     * @param InOutputFolderPath
+     * @param InMaxPendingFramesNum Max number of frames being encoded/written at once
+     * @param InFramesPerShard
+     */
+    FRRDatasetWriter(const FString& InOutputFolderPath, int32 InMaxPendingFramesNum = 64, int32 InFramesPerShard = 1000);
+
+    ~FRRDatasetWriter();
+
+    static constexpr const TCHAR* ANNOTATION_FILE_NAME = TEXT("annotations.jsonl");
+    static constexpr int32 DISK_SPACE_CHECK_FRAMES_INTERVAL = 100;
+
+    /**
+     * @brief Whether a new frame could be enqueued now
+     */
+    bool CanEnqueueFrame() const
+    {
+        return (false == bIsDiskFull) && (PendingFramesNum.GetValue() < MaxPendingFramesNum);
+    }
+
+    /**
+     * @brief Hand over a frame to be written asynchronously. Must be called on game thread.
+     * @param InFrame
+     * @return false if rejected due to the writer being full or the disk running out of space
+     */
+    bool EnqueueFrame(FRRDatasetFrame&& InFrame);
+
+    int32 GetPendingFramesNum() const
+    {
+        return PendingFramesNum.GetValue();
+    }
+
+    /**
+     * @brief Block until all enqueued frames have been written, waiting on their write tasks. Must be called on game thread.
+     */
+    void WaitForCompletion();
+
+    /**
+     * @brief Size of a pixel in #FRRDatasetFrame::ImageData
+     * @param InBitDepth 8, 16 or 32
+     * @return Number of bytes, 0 if InBitDepth is not supported
+     */
+    static int64 GetBytesPerPixel(const int8 InBitDepth);
+
+    /**
+     * @brief Make a single-line JSON annotation of a frame
+     * @param InImageFileName
+     * @param InEntityLogInfos
+     * @return FString
+     */
+    static FString MakeAnnotationLine(const FString& InImageFileName, const TArray<FRREntityLogInfo>& InEntityLogInfos);
+
+    /**
+     * @brief Encode a frame's image data into its file type
+     * @param InFrame
+     * @param OutData
+     * @return true if succeeded
+     */
+    static bool EncodeImage(const FRRDatasetFrame& InFrame, TArray64<uint8>& OutData);
+
+    const FString OutputFolderPath;
+    const int32 MaxPendingFramesNum;
+    const int32 FramesPerShard;
+
+protected:
+    /**
+     * @brief Encode & write a frame with its annotation line into its shard. Run on worker threads.
+     * @param InFrame
+     * @param InFrameIndex
+     */
+    void WriteFrame(const FRRDatasetFrame& InFrame, const int32 InFrameIndex);
+
+    FThreadSafeCounter PendingFramesNum;
+
+    //! Write tasks of frames which were still pending upon the last #EnqueueFrame, only accessed on game thread
+    TArray<TFuture<void>> WriteTasks;
+
+    int32 EnqueuedFramesNum = 0;
+    bool bIsDiskFull = false;
+
+    //! Serialize appends to annotation files
+    FCriticalSection AnnotationFileMutex;
+};
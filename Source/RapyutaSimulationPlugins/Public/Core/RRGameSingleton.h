@@ -27,6 +27,8 @@
 
 #include "RRGameSingleton.generated.h"
 
+DECLARE_DELEGATE_OneParam(FOnSimResourceLoaded, UObject* /*InResource, null if failed*/);
+
 template<const ERRResourceDataType InDataType>
 using URRAssetObject = typename TChooseClass<
     (ERRResourceDataType::UE_STATIC_MESH == InDataType),
@@ -55,7 +57,10 @@ using URRAssetObject = typename TChooseClass<
 /**
  * @brief GameSingleton class which handles asset loading.
  * GameSingleton class can exist during editor usage.
- * - #InitializeResources will async load data into #ResourceMap for each #ERRResourceDataType
+ * - #InitializeResources collates a manifest of all dynamic assets into #ResourceMap for each #ERRResourceDataType, cached on
+ * disk in #GetResourcesManifestFilePath(). Then, if #bOnDemandResourceLoading, only #PreloadResourceUniqueNames are async
+ * loaded, other resources being loaded by #RequestResourceLoading or synchronously upon first #GetSimResource; otherwise all
+ * of them are async loaded.
  * - Get Asset meta data with URRAssetUtils.
  * - Load data with [UAssetManager](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/Engine/UAssetManager/)
  * @sa [GameSingleton](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/Engine/UEngine/GameSingleton/)
@@ -81,6 +86,22 @@ public:
 
     // SIM RESOURCES ==
     //
+    //! Load resources on demand instead of all of them at #InitializeResources
+    UPROPERTY(config)
+    bool bOnDemandResourceLoading = true;
+
+    //! Unload resources of which all holders have called #ReleaseResource, only if #bOnDemandResourceLoading
+    UPROPERTY(config)
+    bool bEvictUnreferencedResources = false;
+
+    //! Unique names of resources used by the scenario, async loaded at #InitializeResources if #bOnDemandResourceLoading
+    UPROPERTY(config)
+    TArray<FString> PreloadResourceUniqueNames = {MATERIAL_NAME_ASSET_MASTER,
+                                                  MATERIAL_NAME_PROP_MASTER,
+                                                  MATERIAL_NAME_PHYSICS_WHEEL,
+                                                  MATERIAL_NAME_TRANSLUCENCE_MASTER,
+                                                  TEXTURE_NAME_WHITE_MASK,
+                                                  TEXTURE_NAME_BLACK_MASK};
 
     /**
      * @brief Read all sim dynamic resouces(Uassets) info from designated folders
@@ -96,6 +117,65 @@ public:
      */
     void FinalizeResources();
 
+    static constexpr const TCHAR* RESOURCES_MANIFEST_FILE_NAME = TEXT("RRResourcesManifest.txt");
+    static constexpr const TCHAR* RESOURCES_MANIFEST_VERSION = TEXT("RRResourcesManifest_v1");
+
+    static FString GetResourcesManifestFilePath()
+    {
+        return FPaths::ProjectSavedDir() / RESOURCES_MANIFEST_FILE_NAME;
+    }
+
+    /**
+     * @brief Collate all dynamic assets info into #ResourceMap, without loading them.
+     * The manifest is read from #GetResourcesManifestFilePath() if its stamp of dynamic assets folders' files num &
+     * modification time is up-to-date, otherwise collated by #CollateAssetsInfo & saved there.
+     * @return Num of assets
+     */
+    int32 BuildResourcesManifest();
+
+    /**
+     * @brief Compose a stamp of all dynamic assets folders' files num & latest modification time, which changes upon any
+     * asset being added, removed or modified.
+     * @return FString
+     */
+    FString ComputeResourcesManifestStamp();
+
+    /**
+     * @brief Async load a resource from the manifest, incrementing its ref count.
+     * Must be called in game thread.
+     * @param InDataType
+     * @param InUniqueName
+     * @param InOnLoaded Optional, run right away if already loaded
+     * @return false if the resource is not in the manifest or asset manager is unavailable
+     */
+    bool RequestResourceLoading(const ERRResourceDataType InDataType,
+                                const FString& InUniqueName,
+                                FOnSimResourceLoaded InOnLoaded = FOnSimResourceLoaded());
+
+    /**
+     * @brief Async load resources by unique names, of any data type
+     * @param InUniqueNames
+     * @return Num of resources found in the manifest
+     */
+    int32 PreloadResources(const TArray<FString>& InUniqueNames);
+
+    /**
+     * @brief Decrement a resource's ref count, unloading it upon reaching 0 if #bEvictUnreferencedResources.
+     * Runtime-generated resources are never evicted.
+     * @param InDataType
+     * @param InUniqueName
+     */
+    void ReleaseResource(const ERRResourceDataType InDataType, const FString& InUniqueName);
+
+    /**
+     * @brief Synchronously load a manifest resource not yet loaded, as the fallback of on-demand loading in #GetSimResource.
+     * Only done in game thread.
+     * @param InDataType
+     * @param InUniqueName
+     * @return UObject*
+     */
+    UObject* LoadResourceSynchronously(const ERRResourceDataType InDataType, const FString& InUniqueName);
+
     // ASSETS --
     //! This list specifically hosts names of which module houses the UE assets based on their data type
     static TMap<ERRResourceDataType, TArray<const TCHAR*>> SASSET_OWNING_MODULE_NAMES;
@@ -230,7 +310,7 @@ public:
      */
     FORCEINLINE static TArray<FString> GetDynamicAssetsPathList(const ERRResourceDataType InDataType)
     {
-        static TArray<FString> runtimeAssetsPathList;
+        TArray<FString> runtimeAssetsPathList;
         for (const auto& moduleName : SASSET_OWNING_MODULE_NAMES[InDataType])
         {
             runtimeAssetsPathList.Emplace(GetDynamicAssetsBasePath(moduleName));
@@ -302,8 +382,9 @@ public:
             return true;
         }
 
-        // 1- COLLATE ALL ASSETS INFO
-        if (0 == CollateAssetsInfo<URRAssetObject<InDataType>>(InDataType, GetAssetsFolderName(InDataType)))
+        // 1- COLLATE ALL ASSETS INFO, unless already done by #BuildResourcesManifest
+        if ((0 == resourceInfo.Data.Num()) &&
+            (0 == CollateAssetsInfo<URRAssetObject<InDataType>>(InDataType, GetAssetsFolderName(InDataType))))
         {
             resourceInfo.bHasBeenAllLoaded = true;
             UE_LOG_WITH_INFO(
@@ -312,39 +393,23 @@ public:
         }
 
         // 2- REQUEST FOR LOADING THE RESOURCES ASYNCHRONOUSLY
-        resourceInfo.ToBeAsyncLoadedResourceNum = resourceInfo.Data.Num();
-        resourceInfo.bHasBeenAllLoaded = false;
 #if RAPYUTA_SIM_VERBOSE
         UE_LOG_WITH_INFO(LogRapyutaCore,
                          Warning,
                          TEXT("[%s] TO BE LOADED NUM: %d"),
                          *URRTypeUtils::GetERRResourceDataTypeAsString(InDataType),
-                         resourceInfo.ToBeAsyncLoadedResourceNum);
+                         resourceInfo.Data.Num());
 #endif
-
-        UAssetManager* assetManager = UAssetManager::GetIfValid();
-        if (assetManager)
+        TArray<FString> uniqueNames;
+        resourceInfo.Data.GetKeys(uniqueNames);
+        for (const auto& uniqueName : uniqueNames)
         {
-            for (const auto& resourceMetaData : resourceInfo.Data)
+            if (false == RequestResourceLoading(InDataType, uniqueName))
             {
-                // https://docs.unrealengine.com/en-US/Resources/SampleGames/ARPG/BalancingBlueprintAndCPP/index.html
-                // "Avoid Referencing Assets by String"
-                FSoftObjectPath resourceSoftObjPath(resourceMetaData.Value.GetAssetPath());
-                assetManager->GetStreamableManager().RequestAsyncLoad(
-                    resourceSoftObjPath,
-                    FStreamableDelegate::CreateUObject(this,
-                                                       &URRGameSingleton::OnResourceLoaded,
-                                                       InDataType,
-                                                       resourceSoftObjPath,
-                                                       resourceMetaData.Value.UniqueName));
+                return false;
             }
-            return true;
-        }
-        else
-        {
-            UE_LOG_WITH_INFO(LogTemp, Error, TEXT("UNABLE TO GET ASSET MANAGER!"))
-            return false;
         }
+        return true;
     }
 
     //! This is used as param to [FStreamableDelegate::CreateUObject()] thus its params could not be constref-ized
@@ -352,6 +417,14 @@ public:
     {
         check(IsInGameThread());
 
+        // Already processed, eg by #LoadResourceSynchronously
+        FRRResource* resourceEntry = GetSimResourceInfo(InDataType).Data.Find(InResourceUniqueName);
+        if ((nullptr == resourceEntry) || (false == resourceEntry->bIsLoading))
+        {
+            return;
+        }
+        resourceEntry->bIsLoading = false;
+
         switch (InDataType)
         {
             case ERRResourceDataType::UE_STATIC_MESH:
@@ -390,6 +463,28 @@ public:
             default:
                 break;
         }
+
+        // Failed ones are also accounted, for #HaveAllResourcesBeenLoaded not to wait for them forever
+        FRRResourceInfo& resourceInfo = GetSimResourceInfo(InDataType);
+        resourceInfo.ToBeAsyncLoadedResourceNum--;
+        if (resourceInfo.ToBeAsyncLoadedResourceNum <= 0)
+        {
+            resourceInfo.ToBeAsyncLoadedResourceNum = 0;
+            resourceInfo.bHasBeenAllLoaded = true;
+        }
+
+        // [resourceEntry] may have been invalidated by [ResourceMap] updates in the callbacks
+        TArray<FOnSimResourceLoaded> onLoadedCallbacks;
+        PendingResourceCallbacks.RemoveAndCopyValue(InResourcePath, onLoadedCallbacks);
+        UObject* resource = resourceInfo.Data.FindRef(InResourceUniqueName).AssetData;
+        if (nullptr == resource)
+        {
+            UE_LOG_WITH_INFO(LogTemp, Error, TEXT("FAILED LOADING RESOURCE [%s]"), *InResourcePath.ToString());
+        }
+        for (auto& onLoaded : onLoadedCallbacks)
+        {
+            onLoaded.ExecuteIfBound(resource);
+        }
     }
 
     /**
@@ -418,7 +513,6 @@ public:
             // Update [ResourceMap] with the newly loaded resource --
             FRRResourceInfo& resourceInfo = GetSimResourceInfo(InDataType);
             resourceInfo.AddResource(InResourceUniqueName, InResourcePath, resource);
-            resourceInfo.ToBeAsyncLoadedResourceNum--;
 #if RAPYUTA_SIM_DEBUG
             UE_LOG_WITH_INFO(LogTemp,
                              Warning,
@@ -429,10 +523,6 @@ public:
                              *InResourcePath.ToString(),
                              resource);
 #endif
-            if (resourceInfo.ToBeAsyncLoadedResourceNum == 0)
-            {
-                resourceInfo.bHasBeenAllLoaded = true;
-            }
 
             // Resource Data --
             // Still need to store resource handle in a direct UPROPERTY() child TArray of this GameSingleton to bypass
@@ -499,7 +589,14 @@ public:
                               const FString& InResourceUniqueName,
                               bool bIsStaticResource = true) const
     {
-        TResource* resourceAsset = Cast<TResource>(GetSimResourceInfo(InDataType).Data.FindRef(InResourceUniqueName).AssetData);
+        const FRRResource* resourceEntry = GetSimResourceInfo(InDataType).Data.Find(InResourceUniqueName);
+        UObject* resourceObject = resourceEntry ? resourceEntry->AssetData : nullptr;
+        if (resourceEntry && (nullptr == resourceObject) && IsInGameThread())
+        {
+            // Manifest resources not yet loaded on demand. [ResourceMap] is a lazily-loaded cache, thus logically const here.
+            resourceObject = const_cast<URRGameSingleton*>(this)->LoadResourceSynchronously(InDataType, InResourceUniqueName);
+        }
+        TResource* resourceAsset = Cast<TResource>(resourceObject);
 
         if (bIsStaticResource && (!resourceAsset))
         {
@@ -767,4 +864,7 @@ private:
     //! We need this to escape UObject-based resource Garbage Collection
     UPROPERTY()
     TArray<UObject*> ResourceStore;
+
+    //! #RequestResourceLoading callbacks of resources being async loaded
+    TMap<FSoftObjectPath, TArray<FOnSimResourceLoaded>> PendingResourceCallbacks;
 };
@@ -0,0 +1,79 @@
+/**
+ * @file RRInstanceIdCaptureComponent.h
+ * @brief Scene capture of 24-bit per-primitive instance ids, for single-capture instance segmentation of dense scenes
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "Components/SceneCaptureComponent2D.h"
+#include "CoreMinimal.h"
+#include "Engine/TextureRenderTarget2D.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRActorCommon.h"
+
+#include "RRInstanceIdCaptureComponent.generated.h"
+
+class ARRMeshActor;
+
+/**
+ * @brief Scene capture of instance ids set by #ARRMeshActor::SetInstanceId into CustomPrimitiveData, as opposed to the
+ * 8-bit custom depth stencil which distinguishes at most 255 instances.
+ * Upon #CaptureInstanceIds, entities & occluders are temporarily rendered with the unlit #InstanceIdMaterialName material,
+ * which outputs CustomPrimitiveData[#URRActorCommon::INSTANCE_ID_CUSTOM_PRIMITIVE_DATA_INDEX, +2] as emissive, into a
+ * 32-bit float render target with exposure, tonemapping & anti-aliasing disabled. Called right after the RGB capture in the
+ * same game thread tick, both captures render the same frame.
+ * @sa [CaptureScene](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/Components/USceneCaptureComponent2D/CaptureScene/)
+ */
+UCLASS(ClassGroup = (Custom), config = RapyutaSimSettings, meta = (BlueprintSpawnableComponent))
+class RAPYUTASIMULATIONPLUGINS_API URRInstanceIdCaptureComponent : public USceneCaptureComponent2D
+{
+    GENERATED_BODY()
+
+public:
+    URRInstanceIdCaptureComponent();
+
+    //! Unlit material outputting the encoded instance id, expected among dynamic material assets
+    UPROPERTY(config, EditAnywhere)
+    FString InstanceIdMaterialName = TEXT("M_RapyutaInstanceId");
+
+    /**
+     * @brief Create the 32-bit float render target & fetch the instance id material
+     * @param InImageSize
+     * @return false if the material is not found
+     */
+    bool Initialize(const FIntPoint& InImageSize);
+
+    /**
+     * @brief Capture instance ids of entities, occluded by occluders (eg scene floor & walls) of which instance id is void.
+     * Other primitives are not rendered.
+     * @param InEntities
+     * @param InOccluders
+     */
+    void CaptureInstanceIds(const TArray<ARRMeshActor*>& InEntities, const TArray<AActor*>& InOccluders);
+
+    /**
+     * @brief Read back the last capture into #FRRColorArray::Float32Colors. Blocking, flushing rendering commands.
+     * @param OutImageData
+     * @return bool
+     */
+    bool ReadInstanceIdImage(FRRColorArray& OutImageData);
+
+    /**
+     * @brief Decode an instance id image into per-pixel ids & visible entities, looked up in an #URRActorCommon's id table
+     * @param InImageData
+     * @param InActorCommon
+     * @param OutInstanceIds Per-pixel instance ids, #URRActorCommon::INSTANCE_ID_VOID for background & unknown ids
+     * @param OutVisibleEntities Id -> Entity of ids present in the image
+     */
+    static void DecodeInstanceIdImage(const FRRColorArray& InImageData,
+                                      const URRActorCommon* InActorCommon,
+                                      TArray<uint32>& OutInstanceIds,
+                                      TMap<uint32, ARRMeshActor*>& OutVisibleEntities);
+
+protected:
+    UPROPERTY()
+    UMaterialInterface* InstanceIdMaterial = nullptr;
+};
@@ -0,0 +1,149 @@
+/**
+ * @file RRJobGraph.h
+ * @brief Dependency-aware async jobs on top of UE task graph (UE::Tasks), with typed results, per-batch completion events,
+ * cooperative cancellation & per-category concurrency limits.
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/ScopeExit.h"
+#include "Tasks/Task.h"
+#include "Tasks/TaskEvent.h"
+#include "Templates/SharedPointer.h"
+
+/**
+ * @brief Cooperative cancellation token shared by a job's tasks.
+ * Tasks not yet started upon #Cancel are skipped, running ones could poll #IsCancelled to bail out early.
+ */
+class RAPYUTASIMULATIONPLUGINS_API FRRJobCancellationToken
+{
+public:
+    void Cancel()
+    {
+        bCancelled = true;
+    }
+
+    bool IsCancelled() const
+    {
+        return bCancelled;
+    }
+
+private:
+    FThreadSafeBool bCancelled = false;
+};
+using FRRJobCancellationTokenRef = TSharedRef<FRRJobCancellationToken, ESPMode::ThreadSafe>;
+
+/**
+ * @brief Launcher of tasks into UE task graph, each optionally:
+ * - Depending on prerequisite tasks, without any thread blocked waiting for them
+ * - Skipped if its #FRRJobCancellationToken has been cancelled before it starts
+ * - Belonging to a job category, of which at most N tasks run at once (#SetCategoryConcurrencyLimit). Each task of a
+ * category requests one of its N slots once its prerequisites are done, then depends on a slot event triggered as soon as
+ * a slot is free. Waiting requests are granted in FIFO order by finishing tasks, thus no worker thread is held by
+ * throttling either.
+ */
+class RAPYUTASIMULATIONPLUGINS_API FRRJobGraph
+{
+public:
+    /**
+     * @brief Set max number of concurrently running tasks of a category, applied to tasks launched afterwards
+     * @param InCategory
+     * @param InConcurrencyLimit <= 0 for unlimited
+     */
+    static void SetCategoryConcurrencyLimit(const FName& InCategory, int32 InConcurrencyLimit);
+
+    static int32 GetCategoryConcurrencyLimit(const FName& InCategory);
+
+    /**
+     * @brief Launch a task returning #TResult, which is default-constructed if the task is skipped upon cancellation.
+     * @param InDebugName
+     * @param InTask
+     * @param InPrerequisites Tasks to complete before #InTask starts
+     * @param InCategory NAME_None for no concurrency limit
+     * @param InCancellationToken Optional
+     * @param InPriority
+     * @return Typed task handle, whose result is fetched by [GetResult()] & which could be a prerequisite of other tasks
+     */
+    template<typename TResult>
+    static UE::Tasks::TTask<TResult> Launch(const TCHAR* InDebugName,
+                                            TUniqueFunction<TResult()> InTask,
+                                            TArray<UE::Tasks::FTask> InPrerequisites = TArray<UE::Tasks::FTask>(),
+                                            const FName& InCategory = NAME_None,
+                                            TSharedPtr<FRRJobCancellationToken, ESPMode::ThreadSafe> InCancellationToken = nullptr,
+                                            const UE::Tasks::ETaskPriority InPriority = UE::Tasks::ETaskPriority::BackgroundNormal)
+    {
+        auto taskBody = [InTask = MoveTemp(InTask), InCancellationToken = MoveTemp(InCancellationToken)]() mutable -> TResult
+        {
+            if (InCancellationToken && InCancellationToken->IsCancelled())
+            {
+                return TResult();
+            }
+            return InTask();
+        };
+
+        if (GetCategoryConcurrencyLimit(InCategory) <= 0)
+        {
+            return UE::Tasks::Launch(InDebugName, MoveTemp(taskBody), InPrerequisites, InPriority);
+        }
+
+        // Request a slot once prerequisites are done, so that tasks waiting for them hold none
+        UE::Tasks::FTaskEvent slotEvent(TEXT("RRJobSlot"));
+        UE::Tasks::Launch(
+            TEXT("RRJobSlotRequest"),
+            [InCategory, slotEvent]() mutable { RequestCategorySlot(InCategory, slotEvent); },
+            InPrerequisites,
+            InPriority);
+
+        return UE::Tasks::Launch(
+            InDebugName,
+            [taskBody = MoveTemp(taskBody), InCategory]() mutable -> TResult
+            {
+                ON_SCOPE_EXIT
+                {
+                    ReleaseCategorySlot(InCategory);
+                };
+                return taskBody();
+            },
+            UE::Tasks::Prerequisites(slotEvent),
+            InPriority);
+    }
+
+private:
+    struct FRRJobCategory
+    {
+        //! <= 0 for unlimited
+        int32 ConcurrencyLimit = 0;
+
+        //! Number of slots held by running tasks
+        int32 RunningTasksNum = 0;
+
+        //! Slot requests waiting for a free slot, in FIFO order
+        TArray<UE::Tasks::FTaskEvent> PendingSlotEvents;
+
+        bool HasFreeSlot() const
+        {
+            return (ConcurrencyLimit <= 0) || (RunningTasksNum < ConcurrencyLimit);
+        }
+    };
+
+    /**
+     * @brief Trigger InOutSlotEvent now if a slot of the category is free, or once one gets freed otherwise
+     * @param InCategory
+     * @param InOutSlotEvent
+     */
+    static void RequestCategorySlot(const FName& InCategory, UE::Tasks::FTaskEvent& InOutSlotEvent);
+
+    /**
+     * @brief Free a slot of the category, handing it over to the oldest pending request if any
+     * @param InCategory
+     */
+    static void ReleaseCategorySlot(const FName& InCategory);
+
+    //! Categories which have ever been limited, kept once unlimited for their running tasks to release their slots
+    static TMap<FName, FRRJobCategory> SCategories;
+    static FCriticalSection SCategoriesMutex;
+};
@@ -74,6 +74,13 @@ public:
      * 
      */
     virtual void Reset() override;
+
+    /**
+     * @brief Unregister #InstanceId from #ActorCommon, freeing it for reuse
+     * @param EndPlayReason
+     */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     void DrawTransform();
 
 public:
@@ -253,6 +260,23 @@ public:
       */
     TArray<int32> GetCustomDepthStencilValueList() const;
 
+    /**
+     * @brief Register a data synth entity to #ActorCommon with an instance id, if not yet.
+     * The id is then kept regardless of activation, until #EndPlay.
+     */
+    void InitInstanceId();
+
+    /**
+     * @brief Set instance id uniformly into all child mesh comps' CustomPrimitiveData
+     * @param InInstanceId #URRActorCommon::INSTANCE_ID_VOID to clear it
+     */
+    void SetInstanceId(uint32 InInstanceId);
+
+    uint32 GetInstanceId() const
+    {
+        return InstanceId;
+    }
+
     //! Delegate on mesh actor being deactivated
     FOnMeshActorDeactivated OnDeactivated;
 
@@ -283,6 +307,10 @@ public:
 
         // RenderCustomDepth (must be after [OnDeactivated], thus its current CustomDepthStencilValue could be stored)
         SetCustomDepthEnabled(bInIsActivated);
+        if (bInIsActivated)
+        {
+            InitInstanceId();
+        }
     }
 
     /**
@@ -301,4 +329,8 @@ protected:
     //! Whether all body meshes are fully created
     UPROPERTY(VisibleAnywhere)
     uint8 bFullyCreated : 1;
+
+    //! Instance id set into child mesh comps' CustomPrimitiveData
+    UPROPERTY(VisibleAnywhere)
+    uint32 InstanceId = URRActorCommon::INSTANCE_ID_VOID;
 };
@@ -22,6 +22,31 @@
 
 #include "RRNetworkPlayerController.generated.h"
 
+/**
+ * @brief Latest velocity command of a robot, pending to be sent to the server by #ARRNetworkPlayerController
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRRRobotVelCommand
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    float ClientTimeStamp = 0.f;
+
+    UPROPERTY()
+    FTransform ClientRobotTransform = FTransform::Identity;
+
+    UPROPERTY()
+    FVector LinearVel = FVector::ZeroVector;
+
+    UPROPERTY()
+    FVector AngularVel = FVector::ZeroVector;
+
+    //! Remaining number of times this command is to be sent
+    UPROPERTY()
+    int32 PendingSendsNum = 0;
+};
+
 /**
  * @brief Network Player controller provides functionality for client-server. Major functionalites are
  * - [UROS2NodeComponent](https://rclue.readthedocs.io/en/devel/doxygen_generated/html/d1/d79/_r_o_s2_node_component_8h.html),  #URRROS2ClockPublisher,  #URRROS2SimulationStateClient are created for each client to provide ROS 2 services which are provided by #ARRROS2GameMode in standalone game.
@@ -165,6 +190,63 @@ public:
                                      const FRotator& InClientRobotRotation,
                                      const FVector& InAngularVel);
 
+    /**
+     * @brief Queue a robot velocity command, to be sent to the server by #FlushRobotVelCommands.
+     * Commands to the same robot are coalesced, so that only the latest one is sent per tick.
+     * Only used if #bCoalesceRobotVelCommands, otherwise robots call #ServerSetLinearVel or #ServerSetAngularVel directly.
+     * @param InServerRobot target server-owned robot
+     * @param InClientTimeStamp
+     * @param InClientRobotTransform
+     * @param InLinearVel
+     * @param InAngularVel
+     */
+    UFUNCTION(BlueprintCallable)
+    virtual void QueueRobotVelCommand(ARRBaseRobot* InServerRobot,
+                                      float InClientTimeStamp,
+                                      const FTransform& InClientRobotTransform,
+                                      const FVector& InLinearVel,
+                                      const FVector& InAngularVel);
+
+    /**
+     * @brief Send queued robot velocity commands via #ServerSetRobotVels, at most one per robot. Called every tick.
+     */
+    void FlushRobotVelCommands();
+
+    /**
+     * @brief Set server robot pose & velocities from a coalesced client command.
+     * Commands older than the last applied one to the same robot are dropped, since the RPC is unreliable.
+     * @param InServerRobot target server-owned robot
+     * @param InClientTimeStamp
+     * @param InClientRobotLocation
+     * @param InClientRobotRotation
+     * @param InLinearVel
+     * @param InAngularVel
+     */
+    UFUNCTION(Server, Unreliable)
+    void ServerSetRobotVels(ARRBaseRobot* InServerRobot,
+                            float InClientTimeStamp,
+                            const FVector_NetQuantize100& InClientRobotLocation,
+                            const FRotator& InClientRobotRotation,
+                            const FVector_NetQuantize100& InLinearVel,
+                            const FVector_NetQuantize100& InAngularVel);
+
+    //! Coalesce robot velocity commands into at most one unreliable RPC per robot per tick, instead of one reliable RPC per
+    //! linear or angular command
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bCoalesceRobotVelCommands = true;
+
+    //! Number of extra times a coalesced command is re-sent in the following ticks, to tolerate packet loss
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 RobotVelCommandResendsNum = 2;
+
+    //! Latest velocity command per robot, pending to be sent
+    UPROPERTY()
+    TMap<ARRBaseRobot*, FRRRobotVelCommand> PendingRobotVelCommands;
+
+    //! Time stamp of the last applied velocity command per robot on server
+    UPROPERTY()
+    TMap<ARRBaseRobot*, float> LastRobotVelCommandTimeStamps;
+
 protected:
     /**
      * @brief
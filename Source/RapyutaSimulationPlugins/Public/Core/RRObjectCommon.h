@@ -8,6 +8,7 @@
 #pragma once
 
 // UE
+#include "Engine/StreamableManager.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "UObject/Object.h"
 
@@ -90,6 +91,15 @@ struct RAPYUTASIMULATIONPLUGINS_API FRRResource
 
     UPROPERTY()
     UObject* AssetData = nullptr;
+
+    //! Num of holders requesting this resource through #URRGameSingleton::RequestResourceLoading
+    int32 RefCount = 0;
+
+    //! Whether an async load of this resource has been requested & not yet completed
+    bool bIsLoading = false;
+
+    //! Set for resources loaded from asset files, which could then be evicted, as opposed to runtime-generated ones
+    TSharedPtr<FStreamableHandle> LoadHandle;
 };
 
 /**
@@ -133,7 +143,11 @@ struct RAPYUTASIMULATIONPLUGINS_API FRRResourceInfo
 
     void AddResource(const FString& InUniqueName, const FSoftObjectPath& InAssetPath, UObject* InAssetData)
     {
-        Data.Add(InUniqueName, FRRResource(InUniqueName, InAssetPath, InAssetData));
+        // Keep loading states of an existing entry, eg one from the resources manifest being loaded on demand
+        FRRResource& resource = Data.FindOrAdd(InUniqueName);
+        resource.UniqueName = InUniqueName;
+        resource.AssetPath = InAssetPath;
+        resource.AssetData = InAssetData;
     }
 
     /**
@@ -168,7 +182,15 @@ struct RAPYUTASIMULATIONPLUGINS_API FRRResourceInfo
         {
             for (auto& [_, resource] : Data)
             {
-                resource.AssetData->MarkAsGarbage();
+                // Manifest entries not loaded on demand have no asset data
+                if (resource.AssetData)
+                {
+                    resource.AssetData->MarkAsGarbage();
+                }
+                if (resource.LoadHandle)
+                {
+                    resource.LoadHandle->ReleaseHandle();
+                }
             }
         }
         Data.Reset();
@@ -0,0 +1,92 @@
+/**
+ * @file RRRobotDescriptionCache.h
+ * @brief Process-wide cache of parsed robot descriptions (URDF/SDF), with binary #FRRRobotModelData serialization.
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+// RapyutaSimulationPlugins
+#include "Robots/RRRobotStructs.h"
+
+using FRRRobotModelInfoConstPtr = TSharedPtr<const FRRRobotModelInfo, ESPMode::ThreadSafe>;
+
+/**
+ * @brief Thread-safe cache of robot model infos parsed by #FRRURDFParser / #FRRSDFParser.
+ * Entries are keyed by the SHA1 of the description file's full path (which mesh paths are resolved against), its content &
+ * its SDF <include> model files' contents, so that edited descriptions or included models are re-parsed.
+ * Parsed models are kept in memory as shared immutable #FRRRobotModelInfo & persisted in #GetCacheFolderPath() if
+ * #SDiskCacheEnabled, so that repeated spawns of the same model are free & later runs only read the cached binary.
+ * @note Cached model infos are shared, thus must be copied before being modified (eg #FRRRobotModelInfo::GetCreatedInstancesNum).
+ */
+class RAPYUTASIMULATIONPLUGINS_API FRRRobotDescriptionCache
+{
+public:
+    static bool SDiskCacheEnabled;
+    static constexpr const TCHAR* CACHE_FOLDER_NAME = TEXT("RRRobotModelCache");
+    static constexpr uint32 MODEL_DATA_FILE_MAGIC = 0x52524D44;    // RRMD
+    //! To be bumped upon any change of #FRRRobotModelData's layout, invalidating all disk cache files
+    static constexpr int32 MODEL_DATA_FILE_VERSION = 1;
+
+    static FString GetCacheFolderPath()
+    {
+        return FPaths::ProjectSavedDir() / CACHE_FOLDER_NAME;
+    }
+
+    /**
+     * @brief Load a robot model info from a URDF/SDF file, from the memory or disk cache if available, else by parsing it.
+     * Could be called from any thread.
+     * @param InDescriptionFilePath
+     * @return Shared immutable model info, null if failed
+     */
+    static FRRRobotModelInfoConstPtr LoadModelInfoFromFile(const FString& InDescriptionFilePath);
+
+    /**
+     * @brief Compute the cache key of a description file
+     * @param InDescriptionFilePath
+     * @param OutHash
+     * @return false if the file could not be read
+     */
+    static bool ComputeDescriptionHash(const FString& InDescriptionFilePath, FString& OutHash);
+
+    /**
+     * @brief Serialize a model data & its child models recursively, in either direction of the archive
+     * @param InOutArchive
+     * @param InOutModelData
+     */
+    static void SerializeModelData(FArchive& InOutArchive, FRRRobotModelData& InOutModelData);
+
+    /**
+     * @brief Save a model data into a versioned binary file
+     * @param InModelData
+     * @param InFilePath
+     * @return true if succeeded
+     */
+    static bool SaveModelDataToFile(const FRRRobotModelData& InModelData, const FString& InFilePath);
+
+    /**
+     * @brief Load a model data from a binary file saved by #SaveModelDataToFile
+     * @param InFilePath
+     * @param OutModelData
+     * @return false if the file is missing, corrupted or of another version
+     */
+    static bool LoadModelDataFromFile(const FString& InFilePath, FRRRobotModelData& OutModelData);
+
+    /**
+     * @brief Clear the memory cache. The disk cache is kept.
+     */
+    static void ClearCache();
+
+private:
+    static FRRRobotModelInfoConstPtr ParseModelInfoFromFile(const FString& InDescriptionFilePath);
+
+    static TMap<FString, FRRRobotModelInfoConstPtr> SModelInfoCache;
+    static FCriticalSection SModelInfoCacheMutex;
+
+    //! [sdf::setFindCallback()] is global, thus SDF parsing is serialized
+    static FCriticalSection SSDFParserMutex;
+};
@@ -0,0 +1,92 @@
+/**
+ * @file RRRobotModelsLoader.h
+ * @brief Concurrent loader of multiple robot/world descriptions & their meshes, for fleet & world bring-up.
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/SharedPointer.h"
+
+// RapyutaSimulationPlugins
+#include "Core/RRMeshData.h"
+#include "Core/RRRobotDescriptionCache.h"
+
+DECLARE_DELEGATE_TwoParams(FOnRobotModelsLoadProgress, int32 /*LoadedItemsNum*/, int32 /*TotalItemsNum*/);
+DECLARE_DELEGATE_OneParam(FOnRobotModelsLoaded, const TArray<FRRRobotModelInfoConstPtr>& /*ModelInfos*/);
+
+/**
+ * @brief Loader of a manifest of URDF/SDF descriptions, which:
+ * 1- Parses all descriptions concurrently through #FRRRobotDescriptionCache
+ * 2- Collects their mesh files, deduplicated across models & skipping ones already in #FRRMeshData's store
+ * 3- Imports all those meshes in parallel, each with its own Assimp importer
+ * 4- Only then, on game thread, adds the mesh data to #FRRMeshData's store & signals #OnLoaded with all model infos, in
+ * manifest order (null for failed ones). Actors constructed afterwards find their mesh data ready in
+ * #URRStaticMeshComponent::InitializeMesh, thus skip per-component async mesh loading.
+ * Progress over parsed descriptions & imported meshes is signalled on game thread through #OnProgress.
+ */
+class RAPYUTASIMULATIONPLUGINS_API FRRRobotModelsLoader : public TSharedFromThis<FRRRobotModelsLoader, ESPMode::ThreadSafe>
+{
+public:
+    /**
+     * @brief Start loading asynchronously. Must be called on game thread.
+     * @param InDescriptionFilePaths Manifest of description files
+     * @param InRobotModelsFolderPath Folder which [package://] & [model://] mesh uris are relative to.
+     * If empty, each description's own folder is used, as for SDF <include> resolution.
+     * @param InOnLoaded
+     * @param InOnProgress
+     * @return The loader, kept alive by its own tasks until completion
+     */
+    static TSharedRef<FRRRobotModelsLoader, ESPMode::ThreadSafe> LoadAsync(const TArray<FString>& InDescriptionFilePaths,
+                                                                          const FString& InRobotModelsFolderPath,
+                                                                          FOnRobotModelsLoaded InOnLoaded,
+                                                                          FOnRobotModelsLoadProgress InOnProgress =
+                                                                              FOnRobotModelsLoadProgress());
+
+    /**
+     * @brief Collect real paths of mesh files referenced by a model data & its child models
+     * @param InModelData
+     * @param InRobotModelsFolderPath
+     * @param OutMeshFilePaths
+     */
+    static void CollectMeshFilePaths(const FRRRobotModelData& InModelData,
+                                     const FString& InRobotModelsFolderPath,
+                                     TSet<FString>& OutMeshFilePaths);
+
+    bool IsCompleted() const
+    {
+        return bIsCompleted;
+    }
+
+    const TArray<FString> DescriptionFilePaths;
+    const FString RobotModelsFolderPath;
+    FOnRobotModelsLoaded OnLoaded;
+    FOnRobotModelsLoadProgress OnProgress;
+
+private:
+    FRRRobotModelsLoader(const TArray<FString>& InDescriptionFilePaths, const FString& InRobotModelsFolderPath)
+        : DescriptionFilePaths(InDescriptionFilePaths), RobotModelsFolderPath(InRobotModelsFolderPath)
+    {
+    }
+
+    //! 1- Parse all descriptions concurrently, run in a worker thread
+    void ParseDescriptions();
+    //! 2- Collect & filter mesh files, run on game thread since #FRRMeshData's store is only accessed there
+    void StartMeshImports();
+    //! 3- Import meshes concurrently, run in a worker thread
+    void ImportMeshes(const TArray<FString>& InMeshFilePaths);
+    //! 4- Hand over mesh data & model infos, run on game thread
+    void Complete();
+    void ReportProgress();
+
+    TArray<FRRRobotModelInfoConstPtr> ModelInfos;
+    TArray<TSharedPtr<FRRMeshData>> MeshDataList;
+
+    //! Total number of descriptions & meshes, set once meshes have been collected
+    FThreadSafeCounter TotalItemsNum;
+    FThreadSafeCounter LoadedItemsNum;
+    bool bIsCompleted = false;
+};
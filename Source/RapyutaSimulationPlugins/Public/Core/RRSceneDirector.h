@@ -18,6 +18,7 @@
 #include "Core/RRActorCommon.h"
 #include "Core/RRBaseActor.h"
 #include "Core/RRCamera.h"
+#include "Core/RRDatasetWriter.h"
 #include "Core/RRGameSingleton.h"
 #include "Core/RRPlayerController.h"
 #include "Core/RRTypeUtils.h"
@@ -69,8 +70,14 @@ public:
 
     FOnSpawnedActorsSettled OnSpawnedActorsSettled;
 
+    /**
+     * @brief Whether operation has completed, including writing of all frames handed to #DatasetWriter
+     */
     virtual bool HasOperationCompleted(bool bIsLogged = false);
 
+    //! Asynchronous dataset sink, to be created by directors which output synthetic data
+    TSharedPtr<FRRDatasetWriter> DatasetWriter;
+
     UPROPERTY()
     double DataCollectionTimeStamp = 0.f;
 
@@ -6,6 +6,8 @@
 
 #include "RRTextureData.generated.h"
 
+class UTextureLightProfile;
+
 USTRUCT()
 struct RAPYUTASIMULATIONPLUGINS_API FRRTextureData
 {
@@ -22,7 +24,7 @@ public:
 };
 
 /**
- * @brief 
+ * @brief Light profile texture data parsed from an IES file
  * @sa [DatasmithRuntime::FTextureData](https://docs.unrealengine.com/4.27/en-US/API/Plugins/DatasmithRuntime/)
  */
 struct RAPYUTASIMULATIONPLUGINS_API FRRLightProfileData
@@ -33,9 +35,39 @@ public:
     int32 Height = 0;
     uint32 Pitch = 0;
     int16 BytesPerPixel = 0;
-    FUpdateTextureRegion2D Region = {0, 0, 0, 0, 0, 0};
-    uint8* ImageData = nullptr;
+    //! RGBA16F texture data
+    TArray<uint8> ImageData;
     // For IES profile
     float Brightness = -FLT_MAX;
     float TextureMultiplier = -FLT_MAX;
 };
+
+/**
+ * @brief Parsed IES profile cached by #URRCoreUtils, together with the light profile texture created from it,
+ * which is shared by all scene instances as long as it is alive.
+ */
+struct RAPYUTASIMULATIONPLUGINS_API FRRCachedLightProfile
+{
+public:
+    //! Time stamp of the IES file when parsed, to detect its modification
+    FDateTime FileTimeStamp;
+    TSharedPtr<FRRLightProfileData> Data;
+    TWeakObjectPtr<UTextureLightProfile> LightProfile;
+};
+
+/**
+ * @brief Image decoded into 8-bit BGRA pixels, ready to be uploaded into a texture.
+ * Produced by worker threads in #URRCoreUtils::LoadImagesFromFolder & cached on disk keyed by the image file's content hash.
+ */
+struct RAPYUTASIMULATIONPLUGINS_API FRRDecodedImageData
+{
+public:
+    int32 Width = 0;
+    int32 Height = 0;
+    TArray64<uint8> BGRAData;
+
+    bool IsValid() const
+    {
+        return (Width > 0) && (Height > 0) && (BGRAData.Num() == int64(Width) * Height * 4);
+    }
+};
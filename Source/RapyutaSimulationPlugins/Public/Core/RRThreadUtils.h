@@ -9,10 +9,14 @@
 // UE
 #include "Async/Async.h"
 #include "Async/AsyncWork.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
 #include "HAL/PlatformProcess.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Misc/ScopeExit.h"
 #include "RenderCommandFence.h"
 #include "RenderingThread.h"
+#include "TimerManager.h"
 
 // RapyutaSimulationPlugins
 #include "Core/RRActorCommon.h"
@@ -20,6 +24,25 @@
 
 #include "RRThreadUtils.generated.h"
 
+/**
+ * @brief Cancellation handle of a task scheduled by #URRThreadUtils::DoTaskInGameThreadLater or
+ * #URRThreadUtils::DoTaskInGameThreadLaterInSimTime
+ */
+struct RAPYUTASIMULATIONPLUGINS_API FRRDelayedTaskHandle
+{
+    //! Wall-time task, scheduled on the core ticker
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    //! Sim-time task, scheduled on #World's timer manager
+    FTimerHandle TimerHandle;
+    TWeakObjectPtr<UWorld> World = nullptr;
+
+    bool IsValid() const
+    {
+        return TickerHandle.IsValid() || TimerHandle.IsValid();
+    }
+};
+
 /**
  * @brief ThreadUtils with Async
  * @sa [Async](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Core/Async/)
@@ -69,18 +92,74 @@ public:
         }
     }
 
+    /**
+     * @brief Run a task in game thread after a wall-time delay. Could be called from any thread.
+     * The delay is tracked by the core ticker, thus no thread is held while waiting.
+     * @param InTaskInGameThread
+     * @param InWaitingTime [sec] Wall-time delay
+     * @param InArgs
+     * @return Handle for #CancelTaskInGameThreadLater
+     */
     template<typename TFunc, typename... TArgs>
-    static void DoTaskInGameThreadLater(TFunc&& InTaskInGameThread, float InWaitingTime, TArgs&&... Args)
+    static FRRDelayedTaskHandle DoTaskInGameThreadLater(TFunc&& InTaskInGameThread, float InWaitingTime, TArgs&&... InArgs)
     {
-        DoAsyncTaskInThread<void>(
-            [InWaitingTime]()
-            {
-                // Wait for the physics to complete the computation given earlier vel cmds
-                FPlatformProcess::Sleep(InWaitingTime);
-            },
-            [InTaskInGameThread = Forward<TFunc>(InTaskInGameThread)]() { DoTaskInGameThread(InTaskInGameThread); });
+        FRRDelayedTaskHandle handle;
+        handle.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateLambda(
+                [InTaskInGameThread = Forward<TFunc>(InTaskInGameThread),
+                 InArgs = MakeTuple(Forward<TArgs>(InArgs)...)](float InDeltaTime)
+                {
+                    InArgs.ApplyBefore(InTaskInGameThread);
+                    // One-shot
+                    return false;
+                }),
+            InWaitingTime);
+        return handle;
+    }
+
+    /**
+     * @brief Run a task in game thread after a sim-time delay, ie paused & dilated along with the world.
+     * Must be called in game thread. The delay is tracked by the world's timer manager.
+     * @param InWorldContextObject
+     * @param InTaskInGameThread
+     * @param InWaitingTime [sec] Sim-time delay
+     * @param InArgs
+     * @return Handle for #CancelTaskInGameThreadLater, invalid if no world is found
+     */
+    template<typename TFunc, typename... TArgs>
+    static FRRDelayedTaskHandle DoTaskInGameThreadLaterInSimTime(const UObject* InWorldContextObject,
+                                                                 TFunc&& InTaskInGameThread,
+                                                                 float InWaitingTime,
+                                                                 TArgs&&... InArgs)
+    {
+        check(IsInGameThread());
+        FRRDelayedTaskHandle handle;
+        UWorld* world = InWorldContextObject ? InWorldContextObject->GetWorld() : nullptr;
+        if (nullptr == world)
+        {
+            return handle;
+        }
+        handle.World = world;
+        auto task = [InTaskInGameThread = Forward<TFunc>(InTaskInGameThread), InArgs = MakeTuple(Forward<TArgs>(InArgs)...)]()
+        { InArgs.ApplyBefore(InTaskInGameThread); };
+        if (InWaitingTime > 0.f)
+        {
+            world->GetTimerManager().SetTimer(handle.TimerHandle, MoveTemp(task), InWaitingTime, false);
+        }
+        else
+        {
+            handle.TimerHandle = world->GetTimerManager().SetTimerForNextTick(MoveTemp(task));
+        }
+        return handle;
     }
 
+    /**
+     * @brief Cancel a task scheduled by #DoTaskInGameThreadLater or #DoTaskInGameThreadLaterInSimTime if not yet run.
+     * Wall-time tasks could be cancelled from any thread, sim-time ones only in game thread.
+     * @param InOutHandle Invalidated here-in
+     */
+    static void CancelTaskInGameThreadLater(FRRDelayedTaskHandle& InOutHandle);
+
     template<typename TResult>
     static auto DoAsyncTaskInThread(TFunction<TResult()> InTask,
                                     TFunction<void()> InCompletionCallback,
@@ -97,29 +176,38 @@ public:
             MoveTemp(InTask),
             TUniqueFunction<void()>([InCompletionCallback = MoveTemp(InCompletionCallback)]() { InCompletionCallback(); }));
     }
+
+    /**
+     * @brief Launch a task of a job through #FRRJobGraph, in the job's category & cancelled along with it
+     * @param OutAsyncJob
+     * @param InCurrentCaptureBatchId
+     * @param InTask
+     * @param InCompletionCallback Run in the same worker thread right after #InTask, unless cancelled
+     * @param InPrerequisites Tasks to complete before #InTask starts, eg a previous batch's completion task
+     * @return Typed task handle
+     */
     template<typename TResult>
-    static void AddAsyncTaskInThreadPool(FRRAsyncJob& OutAsyncJob,
-                                         const uint64 InCurrentCaptureBatchId,
-                                         TFunction<TResult()> InTask,
-                                         TFunction<void()> InCompletionCallback)
+    static UE::Tasks::TTask<TResult> AddAsyncTaskInThreadPool(FRRAsyncJob& OutAsyncJob,
+                                                              const uint64 InCurrentCaptureBatchId,
+                                                              TFunction<TResult()> InTask,
+                                                              TFunction<void()> InCompletionCallback,
+                                                              TArray<UE::Tasks::FTask> InPrerequisites = TArray<UE::Tasks::FTask>())
     {
-#if RAPYUTA_SIM_DEBUG
-        UE_LOG_WITH_INFO(LogTemp,
-                         Warning,
-                         TEXT("[%ld:%s] ASYNC JOB NUM: %d"),
-                         InCurrentCaptureBatchId,
-                         *OutAsyncJob.JobName,
-                         OutAsyncJob.GetTasksNum());
-#endif
-        OutAsyncJob.AddAsyncTask(InCurrentCaptureBatchId, DoAsyncTaskInThread(MoveTemp(InTask), MoveTemp(InCompletionCallback)));
+        return AddAsyncTaskToJob<TResult>(OutAsyncJob,
+                                          InCurrentCaptureBatchId,
+                                          MoveTemp(InTask),
+                                          MoveTemp(InCompletionCallback),
+                                          UE::Tasks::ETaskPriority::BackgroundNormal,
+                                          MoveTemp(InPrerequisites));
     }
 
     template<typename TResult>
-    static void AddAsyncTaskToJob(FRRAsyncJob& OutAsyncJob,
-                                  const uint64 InCurrentCaptureBatchId,
-                                  TFunction<TResult()> InTask,
-                                  TFunction<void()> InCompletionCallback,
-                                  const EAsyncExecution InExecutionThread = EAsyncExecution::ThreadPool)
+    static UE::Tasks::TTask<TResult> AddAsyncTaskToJob(FRRAsyncJob& OutAsyncJob,
+                                                       const uint64 InCurrentCaptureBatchId,
+                                                       TFunction<TResult()> InTask,
+                                                       TFunction<void()> InCompletionCallback,
+                                                       const UE::Tasks::ETaskPriority InPriority = UE::Tasks::ETaskPriority::Normal,
+                                                       TArray<UE::Tasks::FTask> InPrerequisites = TArray<UE::Tasks::FTask>())
     {
 #if RAPYUTA_SIM_DEBUG
         UE_LOG_WITH_INFO(LogTemp,
@@ -129,8 +217,25 @@ public:
                          *OutAsyncJob.JobName,
                          OutAsyncJob.GetTasksNum());
 #endif
-        OutAsyncJob.AddAsyncTask(InCurrentCaptureBatchId,
-                                 DoAsyncTaskInThread(MoveTemp(InTask), MoveTemp(InCompletionCallback), InExecutionThread));
+        UE::Tasks::TTask<TResult> task = FRRJobGraph::Launch<TResult>(
+            TEXT("URRThreadUtils::AddAsyncTaskToJob"),
+            [InTask = MoveTemp(InTask), InCompletionCallback = MoveTemp(InCompletionCallback)]()
+            {
+                ON_SCOPE_EXIT
+                {
+                    if (InCompletionCallback)
+                    {
+                        InCompletionCallback();
+                    }
+                };
+                return InTask();
+            },
+            MoveTemp(InPrerequisites),
+            OutAsyncJob.Category,
+            OutAsyncJob.CancellationToken,
+            InPriority);
+        OutAsyncJob.AddAsyncTask(InCurrentCaptureBatchId, task);
+        return task;
     }
 
     template<typename TAsyncTask>
@@ -618,6 +618,60 @@ public:
                                                      TArray<FVector>* OutCenterAndVertices3D,
                                                      bool bInIncludeNonColliding = true);
 
+    /**
+     * @brief Append the 8 vertices of an actor's local bounding box as its hull into #FRREntityHulls.
+     * @param InActor
+     * @param OutHulls
+     * @param bInIncludeNonColliding
+     * @return Index of the entity in OutHulls
+     */
+    static int32 AddActorBoundingBoxHull(const AActor* InActor, FRREntityHulls& OutHulls, bool bInIncludeNonColliding = true);
+
+    /**
+     * @brief Transform, project & clip hulls of all entities onto an image at once, in parallel per entity.
+     * Each entity's local->clip matrix is composed once, then all its hull points are projected with vectorized matrix math.
+     * Hulls crossing the camera near plane are clipped against it & marked as TRUNCATED.
+     * @param InViewProjectionMatrix World->clip matrix, eg from #ARRCamera::GetViewProjectionMatrix
+     * @param InImageSize Image size in pixels
+     * @param InHulls
+     * @param OutBoxes Resized to the number of entities, reusing its allocations
+     */
+    static void ProjectEntityHulls(const FMatrix& InViewProjectionMatrix,
+                                   const FIntPoint& InImageSize,
+                                   const FRREntityHulls& InHulls,
+                                   FRRProjectedBoundingBoxes& OutBoxes);
+
+    /**
+     * @brief Fill #FRREntityLogInfo::BBVertices2D of all entity groups from their #FRREntityLogInfo::BBVertices3DInWorld,
+     * projected at once by #ProjectEntityHulls. BBVertices2D are the 4 corners of the 2D box clipped to the image, clockwise
+     * from its min corner, or empty if the group is not visible.
+     * @param InViewProjectionMatrix World->clip matrix, eg from #ARRCamera::GetViewProjectionMatrix
+     * @param InImageSize Image size in pixels
+     * @param InOutEntityLogInfos
+     * @param OutHulls Reused buffer
+     * @param OutBoxes Reused buffer, output by #ProjectEntityHulls
+     */
+    static void ProjectEntityLogInfos(const FMatrix& InViewProjectionMatrix,
+                                      const FIntPoint& InImageSize,
+                                      TArray<FRREntityLogInfo>& InOutEntityLogInfos,
+                                      FRREntityHulls& OutHulls,
+                                      FRRProjectedBoundingBoxes& OutBoxes);
+
+    /**
+     * @brief Flag visible boxes of #ProjectEntityHulls as OCCLUDED if line traces from the view location to their hull centers
+     * hit anything other than the entity itself. Traces are run in parallel.
+     * @param InWorld
+     * @param InViewLocation
+     * @param InEntities Entity actors, in the same order as the projected hulls
+     * @param InOutBoxes
+     * @param InTraceChannel
+     */
+    static void CheckEntityHullsOcclusion(const UWorld* InWorld,
+                                          const FVector& InViewLocation,
+                                          const TArray<const AActor*>& InEntities,
+                                          FRRProjectedBoundingBoxes& InOutBoxes,
+                                          ECollisionChannel InTraceChannel = ECC_Visibility);
+
     template<typename TActor>
     static void GetHomoActorGroupCenterAndBoundingBoxVertices(const TArray<TActor*>& InActors,
                                                               const AActor* InBaseActor,
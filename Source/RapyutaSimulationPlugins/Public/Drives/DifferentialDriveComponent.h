@@ -47,7 +47,7 @@ public:
 
     /**
      * @brief Calculate wheel velocity from Velocity(member of UMovementComponent) and #AngularVelocity, and set by calling SetAngularVelocityTarget
-     * SetAngularDriveParams as well.
+     * SetAngularDriveParams as well. Both are only reapplied to the wheel constraints upon change.
      * @param DeltaTime
      * @sa [UPhysicsConstraintComponent](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/PhysicsEngine/UPhysicsConstraintComponent/)
      * @sa [SetAngularVelocityTarget](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/PhysicsEngine/UPhysicsConstraintComponent/SetAngularVeloci-_3/)
@@ -57,6 +57,7 @@ public:
 
     /**
      * @brief Calculate odometry from Velocity and #AngularVelocity.
+     * Not called if the drive is registered to #URRFleetDriveManager, which integrates it with the fleet's ones instead.
      *
      * @param DeltaTime
      *
@@ -64,6 +65,17 @@ public:
      */
     virtual void UpdateOdom(float DeltaTime);
 
+    /**
+     * @brief Init #OdomComponent's odom & reset encoder pose
+     */
+    void InitEncoderOdom();
+
+    /**
+     * @brief Save/load encoder pose, which #OdomComponent's pose is rebuilt from every tick, and the fleet odom noise counter
+     * @param InOutAr
+     */
+    virtual void SerializeDriveState(FArchive& InOutAr) override;
+
     /**
      * @brief Set left and right wheels.
      *
@@ -75,10 +87,12 @@ public:
 
     /**
      * @brief Call Super::Initialize() and #SetPerimeter.
-     *
+     * Register to #URRFleetDriveManager if #bFleetOdomIntegration.
      */
     virtual void Initialize() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /**
      * @brief SetPerimeter from #WheelRadius * 2.f * M_PI
      *
@@ -104,7 +118,21 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     float MaxForce = 1000.f;
 
+    //! Let #URRFleetDriveManager integrate odom together with other drives instead of #UpdateOdom per tick
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bFleetOdomIntegration = false;
+
 protected:
+    friend class URRFleetDriveManager;
+
+    //! Whether registered to #URRFleetDriveManager
+    bool bIsFleetOdomIntegrated = false;
+
+    //! Last values applied to wheel constraints, to skip redundant constraint writes
+    FVector AppliedWheelLeftVelTarget = FVector(MAX_flt);
+    FVector AppliedWheelRightVelTarget = FVector(MAX_flt);
+    float AppliedMaxForce = -1.f;
+
     //! [cm]
     UPROPERTY()
     float WheelPerimeter = 6.28f;
@@ -0,0 +1,114 @@
+/**
+ * @file RRFleetDriveManager.h
+ * @brief Fleet-level odometry integration of differential drives, in a single parallel pass per frame
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RRFleetDriveManager.generated.h"
+
+class UDifferentialDriveComponent;
+
+/**
+ * @brief Fleet drive manager, integrating noisy encoder odometry of all registered #UDifferentialDriveComponent at once,
+ * instead of each drive doing it in its own TickComponent.
+ * Every frame, after all movement components have ticked, drive commands & odom states are gathered into SoA buffers,
+ * integrated in a single ParallelFor, then only changed odom poses are written back.
+ * Odom noise is drawn from per-drive counter-based RNG streams, keyed by the drive's owner & component names, thus
+ * reproducible regardless of the thread that integrates a drive or the registration order of drives.
+ * Kinematic moves themselves stay in each drive's tick, since they sweep against the world on game thread.
+ */
+UCLASS(config = RapyutaSimSettings)
+class RAPYUTASIMULATIONPLUGINS_API URRFleetDriveManager : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //! Seed of drives' odom noise streams
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    int32 NoiseSeed = 0;
+
+    //! Min number of drives integrated per ParallelFor task
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    int32 MinBatchSize = 64;
+
+    /**
+     * @brief Register a drive, whose odom is then integrated by this manager
+     * @param InDrive
+     * @return Whether it is registered
+     */
+    bool RegisterDrive(UDifferentialDriveComponent* InDrive);
+
+    void UnregisterDrive(UDifferentialDriveComponent* InDrive);
+
+    bool IsDriveRegistered(const UDifferentialDriveComponent* InDrive) const
+    {
+        return Drives.Contains(InDrive);
+    }
+
+    /**
+     * @brief Find a registered drive's noise stream counter, eg to save/restore it with the drive's state
+     * @param InDrive
+     * @return nullptr if InDrive is not registered
+     */
+    uint64* FindNoiseCounter(const UDifferentialDriveComponent* InDrive)
+    {
+        const int32 driveIndex = Drives.IndexOfByKey(InDrive);
+        return (INDEX_NONE != driveIndex) ? &NoiseCounters[driveIndex] : nullptr;
+    }
+
+    /**
+     * @brief Integrate odometry of all registered drives
+     * @param InDeltaTime
+     */
+    void IntegrateOdom(float InDeltaTime);
+
+    virtual void Tick(float InDeltaTime) override;
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(URRFleetDriveManager, STATGROUP_Tickables);
+    }
+
+    /**
+     * @brief Standard normal sample of a counter-based RNG stream, ie a pure function of (stream, counter)
+     * @param InStream
+     * @param InCounter
+     * @return float
+     */
+    static float StreamGaussian(const uint64 InStream, const uint64 InCounter);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type InWorldType) const override
+    {
+        return (EWorldType::Game == InWorldType) || (EWorldType::PIE == InWorldType);
+    }
+
+    UPROPERTY()
+    TArray<TWeakObjectPtr<UDifferentialDriveComponent>> Drives;
+
+    //! Per-drive RNG stream ids & counters
+    TArray<uint64> NoiseStreams;
+    TArray<uint64> NoiseCounters;
+
+    // SoA buffers, reused every frame
+    //! [cm/s] Wheels' linear vels
+    TArray<float> WheelVelsL;
+    TArray<float> WheelVelsR;
+    TArray<float> WheelSeparationHalves;
+    //! [cm/s] Noise mean & std dev, zero if noise is disabled
+    TArray<float> NoiseMeans;
+    TArray<float> NoiseStdDevs;
+    //! [cm] & [rad] Encoder poses, in & out
+    TArray<float> PosesX;
+    TArray<float> PosesY;
+    TArray<float> PosesThetaRad;
+    //! [cm/s] & [rad/s] Odom twists, out
+    TArray<float> TwistsLinear;
+    TArray<float> TwistsAngular;
+    TArray<bool> PoseChanged;
+};
@@ -17,6 +17,8 @@
  * This is MovementComponent to move Robot with UE's AIController.
  * This is useful to develop/test higher level logics such as multi robot coordination without emulate low level navigation.
  * Support 2D movement with stick pawn to the floor.
+ * With #bPlanarNavMeshMovement, movement is sweep-free & constrained to the navmesh surface, which suits flat-floor AMRs and
+ * crowd agents, whose agent-agent separation is already handled by Detour crowd.
  * @sa [UFloatingPawnMovement](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/GameFramework/UFloatingPawnMovement/)
  */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
@@ -59,6 +61,35 @@ public:
         bUseAccelerationForPaths = bEnabled;
     }
 
+    void SetSweepEnabled(bool bEnabled)
+    {
+        bSweepEnabled = bEnabled;
+    }
+
+    FORCEINLINE bool IsSweepEnabled() const
+    {
+        return bSweepEnabled;
+    }
+
+    void SetPlanarNavMeshMovement(bool bEnabled)
+    {
+        bPlanarNavMeshMovement = bEnabled;
+        bHasNavMeshProjection = false;
+    }
+
+    FORCEINLINE bool IsPlanarNavMeshMovement() const
+    {
+        return bPlanarNavMeshMovement;
+    }
+
+    //! [cm] Planar distance moved before the navmesh projection & static geometry overlap check are redone
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float NavMeshProjectionDistance = 50.f;
+
+    //! [cm] Vertical extent of navmesh projection queries
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float NavMeshProjectionHeight = 200.f;
+
     void SetPenetrationPullbackDistance(float PullbackDistance)
     {
         PenetrationPullbackDistance = PullbackDistance;
@@ -70,6 +101,18 @@ protected:
     virtual void TickComponent(float InDeltaTime, enum ELevelTick InTickType, FActorComponentTickFunction* InTickFunction) override;
     virtual bool IsExceedingMaxSpeed(float InMaxSpeed) const override;
     virtual FVector GetPenetrationAdjustment(const FHitResult& Hit) const;
+
+    /**
+     * @brief Move #UpdatedComponent planarly on the navmesh without physics sweeps.
+     * Navmesh edges, as blocking geometry, are checked by a navmesh raycast inflated by the agent radius.
+     * The navmesh height is cached & only re-projected every #NavMeshProjectionDistance, together with an overlap test
+     * against static geometry.
+     * @param InDeltaLoc
+     * @param InNewQuat
+     * @param InDeltaTime
+     * @return false if off navmesh or penetrating static geometry, to fall back to sweeping movement
+     */
+    bool MovePlanarOnNavMesh(const FVector& InDeltaLoc, const FQuat& InNewQuat, float InDeltaTime);
 #if RAPYUTA_FLOAT_MOVEMENT_DEBUG
     virtual bool ResolvePenetrationImpl(const FVector& InProposedAdjustment,
                                         const FHitResult& InHit,
@@ -87,4 +130,14 @@ private:
 
     UPROPERTY(EditAnywhere)
     float PenetrationPullbackDistance = 0.f;
+
+    //! Sweep-free movement constrained to the navmesh, by #MovePlanarOnNavMesh
+    UPROPERTY(EditAnywhere)
+    uint8 bPlanarNavMeshMovement : 1;
+
+    //! Cached navmesh projection, valid within #NavMeshProjectionDistance from #LastNavMeshProjectedLocation
+    uint8 bHasNavMeshProjection : 1;
+    FVector LastNavMeshProjectedLocation = FVector::ZeroVector;
+    //! Height of #UpdatedComponent above the navmesh surface
+    float NavMeshHeightOffset = 0.f;
 };
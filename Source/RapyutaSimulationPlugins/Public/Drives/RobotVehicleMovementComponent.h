@@ -28,6 +28,10 @@ class URRFloatingMovementComponent;
  *
  * If #bAdaptToSurfaceBelow is true, robot will follow the pawn movement under the robot which has been defined as the
  #MovingPlatform (e.g. elevators), it will also adapt its pose to the floor surface configuration (e.g. slopes)
+ * Floor rays use simple collision by default and their results are applied in a single transform update per tick, unless
+ * the height offset is swept, in which case the rotation is applied unswept beforehand.
+ * With #bAsyncFloorTrace, floor rays of all vehicles are batched & traced in parallel by the engine's async trace,
+ * results being consumed on the next tick.
 
  *
  * Publish odometry from world origin or initial pose.
@@ -108,6 +112,19 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bAdaptToSurfaceBelow = true;
 
+    //! Trace floor against complex collision instead of simple collision. Must be set before #InitData.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bTraceComplexFloor = false;
+
+    //! Return face index & physical material of floor hits. Must be set before #InitData.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bReturnFloorHitDetails = false;
+
+    //! Trace floor rays asynchronously, so that rays of all vehicles are traced in parallel.
+    //! Results of the previous tick's rays are used, thus floor adaptation has one tick latency.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bAsyncFloorTrace = false;
+
     /**
      * @brief Initialize noise and odometry.
      *
@@ -127,6 +144,12 @@ public:
     UFUNCTION(BlueprintCallable)
     virtual void InitData();
 
+    /**
+     * @brief Save/load drive internal state, ie what is integrated across ticks besides velocities, for #FRRWorldCheckpoint
+     * @param InOutAr
+     */
+    virtual void SerializeDriveState(FArchive& InOutAr);
+
     UFUNCTION(BlueprintCallable)
     void SetMovingPlatform(AActor* platform);
 
@@ -186,6 +209,28 @@ protected:
      */
     virtual void UpdateMovement(float InDeltaTime);
 
+    /**
+     * @brief Adapt the robot pose to the floor below, then apply the result in a single transform update.
+     * With less than 3 #ContactPoints, a single ray beneath the robot is used, otherwise the 3 closest contact points' floor.
+     * @param InDeltaTime
+     */
+    virtual void AdaptToSurfaceBelow(float InDeltaTime);
+
+    /**
+     * @brief Trace floor rays from InRayOrigins, going from +#RayOffsetUp to -#RayOffsetDown.
+     * With #bAsyncFloorTrace, use the results of the previous tick's async traces, whose impact points are projected onto current
+     * ray origins, falling back to a sync trace whenever such result is not available, and request async traces for the next tick.
+     * @param InRayOrigins
+     * @param OutHits Hit result per ray, with bBlockingHit as whether the floor has been hit
+     */
+    void TraceFloor(const TArray<FVector, TInlineAllocator<8>>& InRayOrigins, TArray<FHitResult, TInlineAllocator<8>>& OutHits);
+
+    //! Floor trace params, built once in #InitData
+    FCollisionQueryParams FloorTraceParams;
+
+    //! Pending async floor traces, one per ray
+    TArray<FTraceHandle, TInlineAllocator<8>> FloorTraceHandles;
+
     //! internal property used to log throttle.
     UPROPERTY()
     float LogLastHit = 0.f;
@@ -8,7 +8,6 @@
 
 // UE
 #include "Components/StaticMeshComponent.h"
-#include "Components/WidgetComponent.h"
 #include "CoreMinimal.h"
 
 // rclUE
@@ -50,7 +49,6 @@
 class ARRNetworkGameState;
 class URRRobotROS2Interface;
 class ARRNetworkPlayerController;
-class URRUserWidget;
 
 /**
  * @brief Which server or client has robot movement authority.
@@ -489,26 +487,21 @@ public:
     virtual void InitPropertiesFromJSON();
 
     // UI WIDGET --
+    //! Whether the robot has its label drawn by #URRRobotLabelsOverlay
     UPROPERTY()
     uint8 bUIWidgetEnabled : 1;
-    //! UI widget component
-    UPROPERTY()
-    TObjectPtr<UWidgetComponent> UIWidgetComp = nullptr;
-    //! #URRUserWidget's widget
-    UPROPERTY()
-    TObjectPtr<URRUserWidget> UIUserWidget = nullptr;
 
     //! Relative pose of the UI widget from the owner robot
     UPROPERTY()
     FTransform UIWidgetOffset = FTransform(FVector(0.f, 0.f, 100.f));
 
     /**
-     * @brief Check whether #UIUserWidget is valid
+     * @brief Check whether the robot's label has been registered to #URRRobotLabelsOverlay
      */
     bool CheckUIUserWidget() const;
 
     /**
-     * @brief Set robot's tooltip text through #UIWidgetComp's label
+     * @brief Set robot's tooltip text through its #URRRobotLabelsOverlay label
      * @param InTooltip
      */
     void SetTooltipText(const FString& InTooltip);
@@ -519,7 +512,7 @@ public:
     void SetTooltipVisible(bool bInTooltipVisible);
 
     /**
-     * @brief Set visibility of #UIUserWidget
+     * @brief Set visibility of the robot's #URRRobotLabelsOverlay label
      * @param bInWidgetVisible
      */
     void SetUIWidgetVisible(bool bInWidgetVisible);
@@ -554,7 +547,7 @@ protected:
     virtual void ConfigureMovementComponent();
 
     /**
-     * @brief Create & init #UIWidgetComp
+     * @brief Register the robot's label, with its name as initial text, to #URRRobotLabelsOverlay
      */
     virtual void InitUIWidget();
 };
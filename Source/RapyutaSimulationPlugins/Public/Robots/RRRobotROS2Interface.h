@@ -199,6 +199,13 @@ public:
     UFUNCTION()
     virtual void StopPublishers();
 
+    /**
+     * @brief Restart all publishers stopped by #StopPublishers
+     *
+     */
+    UFUNCTION()
+    virtual void StartPublishers();
+
     /**
      * @brief Initialize subscriptions for cmd_vel & joint_states topics
      * Overidden in child robot ROS 2 interface classes for specialized topic subscriptions.
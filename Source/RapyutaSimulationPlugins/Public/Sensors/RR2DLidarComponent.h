@@ -72,14 +72,6 @@ public:
      */
     void SensorUpdate() override;
 
-    /**
-     * @brief Return true if laser hits the target actor.
-     * @param TargetActor
-     * @return true
-     * @return false
-     */
-    bool Visible(AActor* TargetActor) override;
-
     UFUNCTION(BlueprintCallable)
     /**
      * @brief Create ROS 2 Msg structure from #RecordedHits
@@ -101,4 +93,15 @@ public:
 
     UFUNCTION(BlueprintCallable)
     float GetMaxAngleRadians() const;
+
+protected:
+    /**
+     * @brief In addition to horizontal FOV & range, the target's bounding sphere must cross the scan plane
+     */
+    virtual bool IsInScanFOV(const FVector& InLocalCenter, const float InRadius) const override;
+
+    /**
+     * @brief Probes projected onto the scan plane
+     */
+    virtual void GetVisibilityProbes(const FBox& InTargetBounds, TArray<FVector, TInlineAllocator<9>>& OutProbes) const override;
 };
@@ -65,14 +65,6 @@ public:
      */
     void SensorUpdate() override;
 
-    /**
-     * @brief Return true if laser hits the target actor.
-     * @param TargetActor
-     * @return true
-     * @return false
-     */
-    bool Visible(AActor* TargetActor) override;
-
     /**
      * @brief Create ROS 2 Msg structure from #RecordedHits
      * This should probably be removed so that the sensor can be decoupled from the message types
@@ -112,4 +104,10 @@ public:
     //! [degrees]
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
     float DVAngle = 0.f;
+
+protected:
+    /**
+     * @brief In addition to horizontal FOV & range, the target's bounding sphere must overlap the vertical FOV
+     */
+    virtual bool IsInScanFOV(const FVector& InLocalCenter, const float InRadius) const override;
 };
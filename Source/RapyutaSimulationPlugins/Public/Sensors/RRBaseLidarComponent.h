@@ -14,6 +14,7 @@
 // UE
 #include "Components/StaticMeshComponent.h"
 #include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
 
 // RapyutaSimulationPlugins
 #include "RRROS2BaseSensorComponent.h"
@@ -41,17 +42,27 @@ protected:
 
 public:
     /**
-     * @brief Return true if laser hits the target actor. This method should be overwritten by child class.
-     * @param TargetActor 
-     * @return true 
-     * @return false 
+     * @brief Return true if laser hits the target actor, without re-tracing the full scan:
+     * 1- Reject the target if its bounds are out of range or out of scan FOV (#IsInScanFOV)
+     * 2- If the last completed scan is not older than #MaxVisibilityScanAge, look the target up in its hit actors
+     * 3- Otherwise, trace a few rays aimed at the target's bounds (#GetVisibilityProbes)
+     * @param TargetActor
+     * @return true
+     * @return false
      */
     UFUNCTION(BlueprintCallable)
-    virtual bool Visible(AActor* TargetActor)
-    {
-        checkNoEntry();
-        return false;
-    }
+    virtual bool Visible(AActor* TargetActor);
+
+    /**
+     * @brief Batch version of #Visible, tracing probe rays of all targets needing them at once
+     * @param InTargetActors
+     * @param OutVisibilities
+     */
+    virtual void Visible(const TArray<AActor*>& InTargetActors, TArray<bool>& OutVisibilities);
+
+    //! [s] Max age of the last completed scan, beyond which #Visible traces probe rays instead of using its hits
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float MaxVisibilityScanAge = 0.2f;
 
     /**
      * @brief Get #RecordedHits and #TimeOfLastScan.
@@ -160,4 +171,37 @@ protected:
 
     FLinearColor InterpolateColor(float InX);
     static float GetIntensityFromDist(float InBaseIntensity, float InDistance);
+
+    //! Actors hit by the last completed scan, updated by #UpdateScanHitActors
+    TSet<TObjectKey<AActor>> ScanHitActors;
+
+    //! [s] Time at which #ScanHitActors was updated, < 0 if never
+    float ScanHitActorsTime = -1.f;
+
+    /**
+     * @brief Update #ScanHitActors from #RecordedHits, once a scan has completed
+     */
+    void UpdateScanHitActors();
+
+    /**
+     * @brief Stage 1 of #Visible: whether a target's bounding sphere, in this lidar's frame, overlaps the scan range & FOV.
+     * Child classes extend it with their vertical FOV.
+     * @param InLocalCenter
+     * @param InRadius
+     * @return bool
+     */
+    virtual bool IsInScanFOV(const FVector& InLocalCenter, const float InRadius) const;
+
+    /**
+     * @brief Stage 3 of #Visible: world points of a target's bounds at which probe rays are aimed
+     * @param InTargetBounds
+     * @param OutProbes
+     */
+    virtual void GetVisibilityProbes(const FBox& InTargetBounds, TArray<FVector, TInlineAllocator<9>>& OutProbes) const;
+
+    /**
+     * @brief Trace probe rays from this lidar towards each of InProbes
+     * @return true if any of them first hits InTargetActor
+     */
+    bool TraceVisibilityProbes(const AActor* InTargetActor, const TArray<FVector, TInlineAllocator<9>>& InProbes) const;
 };
@@ -93,6 +93,15 @@ public:
      */
     virtual void UpdateOdom(float InDeltaTime);
 
+    /**
+     * @brief Save/load odom internal state, ie odom origin, last true & noisy poses, odom data and noise RNG state, for
+     * #FRRWorldCheckpoint
+     * @param InOutAr
+     * @param bInRestoreTime Whether to load saved update time & stamp, otherwise they are set to the current sim time so that
+     * the next update does not span the time elapsed since saving
+     */
+    virtual void SerializeOdomState(FArchive& InOutAr, const bool bInRestoreTime = true);
+
     //! Publish tf or not
     //! @todo move this to publisher
     UPROPERTY(BlueprintReadWrite)
@@ -22,6 +22,18 @@ DECLARE_LOG_CATEGORY_EXTERN(LogROS2Sensor, Log, All);
 
 #define TRACE_ASYNC 1
 
+/**
+ * @brief Priority class of a degradable sensor for #URRSensorBudgetManager.
+ * Lower priority sensors are throttled first and restored last.
+ */
+UENUM(BlueprintType)
+enum class ERRSensorBudgetPriority : uint8
+{
+    LOW UMETA(DisplayName = "Low"),
+    MEDIUM UMETA(DisplayName = "Medium"),
+    HIGH UMETA(DisplayName = "High")
+};
+
 /**
  * @brief Base ROS 2 Sensor Component class. Other sensors class should inherit from this class.
  * Provide features to initialize with [UROS2NodeComponent](https://rclue.readthedocs.io/en/devel/doxygen_generated/html/d1/d79/_r_o_s2_node_component_8h.html)
@@ -101,6 +113,26 @@ public:
     UFUNCTION(BlueprintCallable)
     virtual void Stop();
 
+    /**
+     * @brief Change the running sensor update & publication rate, clamped within
+     * [#MinPublicationFrequencyHz, #PublicationFrequencyHz], without resetting the sensor as #Run does.
+     * @param InFrequencyHz
+     * @sa #URRSensorBudgetManager
+     */
+    UFUNCTION(BlueprintCallable)
+    virtual void SetCurrentPublicationFrequencyHz(const int32 InFrequencyHz);
+
+    /**
+     * @brief Get then reset the accumulated SensorUpdate cost
+     * @return [s] Real time spent in #SensorUpdate since the last call
+     */
+    double ConsumeUpdateCost()
+    {
+        const double cost = UpdateCost;
+        UpdateCost = 0.0;
+        return cost;
+    }
+
     /**
      * @brief Update Sensor data. This method should be overwritten by child class.
      */
@@ -134,6 +166,20 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 PublicationFrequencyHz = 30;
 
+    //! Whether #URRSensorBudgetManager may lower this sensor's rate, down to #MinPublicationFrequencyHz, to hold the target RTF
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bDegradable = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    ERRSensorBudgetPriority BudgetPriority = ERRSensorBudgetPriority::MEDIUM;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 MinPublicationFrequencyHz = 1;
+
+    //! Rate in use since #Run, below #PublicationFrequencyHz while throttled
+    UPROPERTY(Transient, BlueprintReadOnly)
+    int32 CurrentPublicationFrequencyHz = 0;
+
     //! Append namespace to #FrameId or not.
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bAppendNodeNamespace = true;
@@ -144,4 +190,10 @@ public:
 protected:
     UPROPERTY()
     FTimerHandle TimerHandle;
+
+    //! Timer callback, calling #SensorUpdate and accumulating its cost into #UpdateCost
+    void TimedSensorUpdate();
+
+    //! [s]
+    double UpdateCost = 0.0;
 };
@@ -0,0 +1,92 @@
+/**
+ * @file RRROS2JointStateSensorComponent.h
+ * @brief JointState sensor component which publishes states of the owner #ARRBaseRobot's joints.
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+
+// rclUE
+#include "Msgs/ROS2JointState.h"
+
+// RapyutaSimulationPlugins
+#include "Drives/RRJointComponent.h"
+#include "RRROS2BaseSensorComponent.h"
+#include "Tools/RRROS2JointStatePublisher.h"
+
+#include "RRROS2JointStateSensorComponent.generated.h"
+
+/**
+ * @brief JointState sensor component which publishes position, velocity & effort of the owner #ARRBaseRobot's #ARRBaseRobot::Joints.
+ * Joint names & their order are resolved once into #JointComponents upon publisher initialization,
+ * then each #SensorUpdate only fills the preallocated arrays of #Data without any string or map operation.
+ * Supports only 1 DOF joints. Effort is always 0 since joints are not effort controlled.
+ *
+ * @note #URRRobotROS2Interface subscribes to [joint_states] as joint commands by default. Either #TopicName or
+ * #URRRobotROS2Interface::JointsCmdTopicName should be changed if both are used in the same robot.
+ * @sa [sensor_msgs/JointState](http://docs.ros.org/en/noetic/api/sensor_msgs/html/msg/JointState.html)
+ */
+UCLASS(ClassGroup = (Custom), Blueprintable, meta = (BlueprintSpawnableComponent))
+class RAPYUTASIMULATIONPLUGINS_API URRROS2JointStateSensorComponent : public URRROS2BaseSensorComponent
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * @brief Construct a new URRROS2JointStateSensorComponent object
+     *
+     */
+    URRROS2JointStateSensorComponent();
+
+    /**
+     * @brief Build the joint buffer by calling #InitJointBuffer in addition to Super::PreInitializePublisher()
+     *
+     * @param InROS2Node ROS2Node which this publisher belongs to
+     * @param InTopicName
+     */
+    virtual void PreInitializePublisher(UROS2NodeComponent* InROS2Node, const FString& InTopicName) override;
+
+    /**
+     * @brief Resolve joint components from the owner robot's #ARRBaseRobot::Joints in a fixed order
+     * and preallocate name, position, velocity & effort arrays of #Data.
+     * If #JointNames is empty, all joints of the owner robot are used.
+     * @return true if at least one joint has been resolved
+     */
+    UFUNCTION(BlueprintCallable)
+    virtual bool InitJointBuffer();
+
+    /**
+     * @brief Fill #Data's preallocated arrays from #JointComponents, converting UE->ROS units.
+     */
+    virtual void SensorUpdate() override;
+
+    // ROS
+    /**
+     * @brief return #Data
+     *
+     * @return FROSJointState
+     */
+    UFUNCTION(BlueprintCallable)
+    virtual FROSJointState GetROS2Data();
+
+    /**
+     * @brief Set #Data to InMessage.
+     *
+     * @param InMessage
+     */
+    virtual void SetROS2Msg(UROS2GenericMsg* InMessage) override;
+
+    //! Names of joints to publish, in publishing order. If empty, all joints of the owner robot are published.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FString> JointNames;
+
+    //! Joint components resolved by #InitJointBuffer, in the same order as #Data's name array.
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    TArray<URRJointComponent*> JointComponents;
+
+    UPROPERTY(BlueprintReadWrite)
+    FROSJointState Data;
+};
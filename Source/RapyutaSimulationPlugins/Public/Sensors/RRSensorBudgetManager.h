@@ -0,0 +1,146 @@
+/**
+ * @file RRSensorBudgetManager.h
+ * @brief Frame budget controller, throttling degradable sensors' rates to hold the target RTF
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RRSensorBudgetManager.generated.h"
+
+class UROS2NodeComponent;
+class URRROS2BaseSensorComponent;
+class URRROS2StringPublisher;
+
+/**
+ * @brief Frame budget controller of all running #URRROS2BaseSensorComponent.
+ * Each frame, the game thread work time, ie frame time minus the time waited by #URRLimitRTFFixedSizeCustomTimeStep,
+ * is compared to the frame budget to hold the target RTF, ie StepSize / TargetRTF.
+ * - While over budget, the cheapest-to-lose sensor, ie the costliest one of the lowest priority class among those marked
+ *   #URRROS2BaseSensorComponent::bDegradable, has its rate lowered by #ThrottleFactor, down to its
+ *   #URRROS2BaseSensorComponent::MinPublicationFrequencyHz.
+ * - Once the work time has stayed below #RestoreRatio of the budget for #RestoreHoldSeconds, throttled sensors are restored in
+ *   reverse, ie highest priority class first, up to their nominal #URRROS2BaseSensorComponent::PublicationFrequencyHz.
+ *
+ * At most one adjustment is made per #AdjustmentIntervalSeconds, letting the frame time settle in between, and each one is
+ * reported on #DiagnosticsTopicName, together with the per-sensor & per-robot costs it is based on.
+ */
+UCLASS(config = RapyutaSimSettings)
+class RAPYUTASIMULATIONPLUGINS_API URRSensorBudgetManager : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    bool bEnabled = true;
+
+    //! Target RTF if the engine does not use #URRLimitRTFFixedSizeCustomTimeStep
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float DefaultTargetRTF = 1.f;
+
+    //! Throttle while the smoothed work time is above this ratio of the frame budget
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float ThrottleRatio = 1.f;
+
+    //! Restore once the smoothed work time is below this ratio of the frame budget
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float RestoreRatio = 0.75f;
+
+    //! [s] Real time the headroom must last for before restoring, also since the last throttling
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float RestoreHoldSeconds = 2.f;
+
+    //! [s] Min real time between two adjustments
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float AdjustmentIntervalSeconds = 0.5f;
+
+    //! Rate multiplier per throttling step, its inverse per restoring step
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float ThrottleFactor = 0.5f;
+
+    //! Exponential smoothing factor of measured times, in (0, 1]
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float SmoothingFactor = 0.1f;
+
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    FString DiagnosticsTopicName = TEXT("sensor_budget");
+
+    void RegisterSensor(URRROS2BaseSensorComponent* InSensor);
+    void UnregisterSensor(URRROS2BaseSensorComponent* InSensor);
+
+    /**
+     * @brief Create #DiagnosticsPublisher, publishing adjustments to #DiagnosticsTopicName
+     * @param InROS2Node
+     */
+    void InitDiagnosticsPublisher(UROS2NodeComponent* InROS2Node);
+
+    /**
+     * @brief [s] Real time per frame available to game thread work to hold the target RTF
+     * @param InDeltaTime Sim time step
+     * @return float
+     */
+    float GetFrameBudget(float InDeltaTime) const;
+
+    float GetSmoothedWorkTime() const
+    {
+        return SmoothedWorkTime;
+    }
+
+    virtual void Tick(float InDeltaTime) override;
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(URRSensorBudgetManager, STATGROUP_Tickables);
+    }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type InWorldType) const override
+    {
+        return (EWorldType::Game == InWorldType) || (EWorldType::PIE == InWorldType);
+    }
+
+    /**
+     * @brief Lower the rate of the lowest priority, costliest degradable sensor
+     * @return Whether a sensor has been throttled
+     */
+    bool ThrottleSensor();
+
+    /**
+     * @brief Raise back the rate of the highest priority, cheapest throttled sensor
+     * @return Whether a sensor has been restored
+     */
+    bool RestoreSensor();
+
+    /**
+     * @brief Apply a new rate to #Sensors[InSensorIndex] and report it on #DiagnosticsTopicName
+     * @param InSensorIndex
+     * @param InFrequencyHz
+     * @param InReason
+     */
+    void AdjustSensor(const int32 InSensorIndex, const int32 InFrequencyHz, const TCHAR* InReason);
+
+    //! [s] Smoothed SensorUpdate cost of all registered sensors owned by InOwner
+    float GetOwnerCost(const AActor* InOwner) const;
+
+    UPROPERTY()
+    TArray<TWeakObjectPtr<URRROS2BaseSensorComponent>> Sensors;
+
+    //! [s] Per-sensor smoothed SensorUpdate cost per frame, parallel to #Sensors
+    TArray<float> SensorCosts;
+
+    UPROPERTY(Transient)
+    URRROS2StringPublisher* DiagnosticsPublisher = nullptr;
+
+    //! [s] Smoothed game thread work time per frame, ie excluding RTF-limiting waits
+    float SmoothedWorkTime = 0.f;
+    float LastFrameBudget = 0.f;
+
+    //! [s] Platform times
+    double LastTickTime = 0.0;
+    double LastAdjustmentTime = 0.0;
+    double LastThrottleTime = 0.0;
+    double HeadroomStartTime = 0.0;
+};
@@ -0,0 +1,193 @@
+/**
+ * @file RRCommandRecorder.h
+ * @brief Record & deterministic replay of inbound ROS 2 commands, for reproducible performance runs
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+// RapyutaSimulationPlugins
+#include "Drives/RRJointComponent.h"
+
+#include "RRCommandRecorder.generated.h"
+
+class ARRBaseRobot;
+class ASimulationState;
+
+UENUM(BlueprintType)
+enum class ERRCommandRecorderMode : uint8
+{
+    NONE UMETA(DisplayName = "None"),
+    RECORD UMETA(DisplayName = "Record"),
+    REPLAY UMETA(DisplayName = "Replay")
+};
+
+/**
+ * @brief Type of a recorded command, ie the game thread handler it is applied through
+ */
+enum class ERRRecordedCommandType : uint8
+{
+    //! #ARRBaseRobot::SetLinearVel & #ARRBaseRobot::SetAngularVel, from #URRRobotROS2Interface::MovementCallback
+    CMD_VEL,
+    //! #ARRBaseRobot::SetJointState, from #URRRobotROS2Interface::JointStateCallback
+    JOINT_STATE,
+    //! #ASimulationState server operations, from #URRROS2SimulationStateClient services
+    SET_ENTITY_STATE,
+    ATTACH,
+    SPAWN_ENTITY,
+    DELETE_ENTITY,
+    WORLD_CHECKPOINT
+};
+
+/**
+ * @brief Recorder of inbound ROS 2 commands, ie robots' cmd_vel & joint commands and sim state service requests, replaying
+ * them without any ROS 2 traffic so that a scenario is re-run headless with a fixed workload, eg to bisect sim throughput
+ * regressions between plugin versions.
+ * - Record: each command is logged as it is applied on game thread, after ROS to UE conversion, stamped with the number of
+ *   world ticks started so far & the sim time at the current tick start. The log is written to #LogFilePath upon world
+ *   teardown or #SaveLog.
+ * - Replay: commands are applied through the same game thread handlers at the start of the same world tick they were recorded
+ *   in, ie before any actor tick as game thread tasks would be, while live commands are ignored. It is bit-for-bit
+ *   comparable given a fixed time step, eg via #URRLimitRTFFixedSizeCustomTimeStep, and a sim time drift against the log is
+ *   warned about.
+ *
+ * Besides #Mode, `-RRCommandRecord=<file>` or `-RRCommandReplay=<file>` could be passed on the command line, plus
+ * `-RRCommandReplayExit` to quit once the log is fully replayed.
+ * The log is a compact binary one: a header, then per command its tick, sim time, type & a size-prefixed payload.
+ * Sim state requests are stored with tagged struct serialization, thus still readable if ue_msgs fields are added.
+ */
+UCLASS(config = RapyutaSimSettings)
+class RAPYUTASIMULATIONPLUGINS_API URRCommandRecorder : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr uint32 MAGIC = 0x5252434C;    // "RRCL"
+    static constexpr uint32 VERSION = 1;
+
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    ERRCommandRecorderMode Mode = ERRCommandRecorderMode::NONE;
+
+    //! Relative to the project saved dir if not absolute
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    FString LogFilePath = TEXT("CommandLog.rrcl");
+
+    //! Request engine exit once the whole log has been replayed
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    bool bExitOnReplayEnd = false;
+
+    virtual void Initialize(FSubsystemCollectionBase& InCollection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    bool IsRecording() const
+    {
+        return ERRCommandRecorderMode::RECORD == Mode;
+    }
+
+    //! Live commands must be ignored while this is true
+    bool IsReplaying() const
+    {
+        return ERRCommandRecorderMode::REPLAY == Mode;
+    }
+
+    /**
+     * @brief Write the commands recorded so far to #LogFilePath
+     * @return Whether the log has been written
+     */
+    bool SaveLog() const;
+
+    void RecordCmdVel(const ARRBaseRobot* InRobot, const FVector& InLinearVel, const FVector& InAngularVel);
+    void RecordJointState(const ARRBaseRobot* InRobot,
+                          const TMap<FString, TArray<float>>& InJointState,
+                          const ERRJointControlType InJointControlType);
+
+    /**
+     * @brief Record a sim state request, of ue_msgs request struct type
+     * @param InType
+     * @param InRequest
+     * @param InNetworkPlayerId Only used by #ERRRecordedCommandType::SPAWN_ENTITY
+     */
+    template<typename TRequest>
+    void RecordSimStateRequest(const ERRRecordedCommandType InType, const TRequest& InRequest, const int32 InNetworkPlayerId = 0)
+    {
+        RecordSimStateRequest(InType, TRequest::StaticStruct(), &InRequest, InNetworkPlayerId);
+    }
+
+    void RecordWorldCheckpoint(const bool bInSave);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type InWorldType) const override
+    {
+        return (EWorldType::Game == InWorldType) || (EWorldType::PIE == InWorldType);
+    }
+
+    void RecordSimStateRequest(const ERRRecordedCommandType InType,
+                               UScriptStruct* InRequestStruct,
+                               const void* InRequest,
+                               const int32 InNetworkPlayerId);
+
+    /**
+     * @brief Write a command's header & size-prefixed payload into #LogData
+     * @param InType
+     * @param InSerializePayload
+     */
+    void RecordCommand(const ERRRecordedCommandType InType, TFunctionRef<void(FArchive&)> InSerializePayload);
+
+    /**
+     * @brief Advance #TickCount then replay its commands, bound to FWorldDelegates::OnWorldTickStart
+     * @param InWorld
+     * @param InTickType
+     * @param InDeltaSeconds
+     */
+    void OnWorldTickStart(UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds);
+
+    /**
+     * @brief Apply all logged commands recorded up to InTick, in order
+     * @param InTick
+     */
+    void ReplayCommands(const int64 InTick);
+
+    /**
+     * @brief Apply a command's payload through its game thread handler
+     * @param InType
+     * @param InOutAr Payload reader
+     * @return false if the command could not be applied
+     */
+    bool ApplyCommand(const ERRRecordedCommandType InType, FArchive& InOutAr);
+
+    ARRBaseRobot* FindRobot(const FString& InRobotName);
+
+    ASimulationState* FindSimState();
+
+    FString GetFullLogFilePath() const;
+
+    //! Header & commands, recorded or loaded
+    TArray<uint8> LogData;
+
+    //! Read offset in #LogData of the next command to replay
+    int64 ReplayOffset = 0;
+
+    //! Number of world ticks started since world begin play
+    int64 TickCount = 0;
+
+    //! [s] Sim time at the current tick start, before the world advances it
+    double TickStartTime = 0.0;
+
+    FDelegateHandle WorldTickStartHandle;
+
+    bool bHasBegunPlay = false;
+    bool bReplayFinished = false;
+    bool bWarnedTimeDrift = false;
+
+    UPROPERTY()
+    TMap<FString, TWeakObjectPtr<ARRBaseRobot>> RobotCache;
+
+    UPROPERTY()
+    TWeakObjectPtr<ASimulationState> SimState = nullptr;
+};
@@ -20,6 +20,9 @@ class AROS2Node;
 /**
  * @brief Rviz marker array publisher class. This class publishes markers for given actors.
  * Expected to create child class in BP/C++ to set marker params and actor class.
+ * Markers are kept in a persistent buffer, in which only stamp & pose are updated per publish.
+ * With #bPublishOnlyChangedMarkers, only markers of actors which have moved beyond thresholds are sent, plus DELETE markers of
+ * destroyed actors.
  */
 UCLASS(ClassGroup = (Custom), Blueprintable, meta = (BlueprintSpawnableComponent))
 class RAPYUTASIMULATIONPLUGINS_API URRROS2ActorsRvizMarkerPublisher : public UROS2Publisher
@@ -46,15 +49,84 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     AActor* ReferenceActor = nullptr;
 
-    //! Update Actors with GetAllActorsOfClass or not in UpdateMessages
-    //! Enable this may cause delay since GetAllActorsOfClass is slow operation.
+    //! Track actors of #ActorClass in #Actors or not.
+    //! GetAllActorsOfClass is called only once, then #Actors is updated upon actor spawn/destroy.
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bUpdateActorsList = false;
 
+    //! Only publish markers of actors which have moved beyond #MarkerPositionThreshold/#MarkerOrientationThreshold since last
+    //! published, plus DELETE markers of destroyed actors.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bPublishOnlyChangedMarkers = false;
+
+    //! [cm] Position threshold used by #bPublishOnlyChangedMarkers
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float MarkerPositionThreshold = 1.f;
+
+    //! Orientation (quaternion) threshold used by #bPublishOnlyChangedMarkers
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float MarkerOrientationThreshold = 1.e-3f;
+
     //! Common parameters among Markers
     //! Parameters are used from this one except for name and pose.
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FROSMarker BaseMarker;
 
     void UpdateMessage(UROS2GenericMsg* InMessage) override;
+
+    /**
+     * @brief Unregister actor spawn handler in addition to Super::BeginDestroy()
+     */
+    void BeginDestroy() override;
+
+protected:
+    /**
+     * @brief Fetch #Actors with GetAllActorsOfClass once & register actor spawn handler to keep it updated.
+     */
+    void InitActorsList();
+
+    /**
+     * @brief Rebuild marker buffer from #Actors, eg when #Actors has been modified externally.
+     */
+    void RefreshMarkers();
+
+    /**
+     * @brief Add actor to #Actors & marker buffer.
+     *
+     * @param InActor
+     */
+    void AddActor(AActor* InActor);
+
+    /**
+     * @brief Add #ActorClass actor to #Actors upon its spawning.
+     *
+     * @param InActor
+     */
+    void OnActorSpawned(AActor* InActor);
+
+    /**
+     * @brief Remove actor from #Actors & marker buffer upon its destruction, queuing its DELETE marker.
+     *
+     * @param InActor
+     */
+    UFUNCTION()
+    void OnActorDestroyed(AActor* InActor);
+
+    //! Persistent markers, one per actor in #Actors in the same order
+    UPROPERTY()
+    FROSMarkerArray MarkersMsg;
+
+    //! Message buffer of changed & deleted markers
+    UPROPERTY()
+    FROSMarkerArray ChangedMarkersMsg;
+
+    //! Relative transforms last published per actor in #Actors. Unset if not yet published.
+    TArray<TOptional<FTransform>> LastPublishedTransforms;
+
+    //! Names of destroyed actors whose DELETE markers are pending
+    TArray<FString> RemovedActorNames;
+
+    FDelegateHandle ActorSpawnedHandle;
+
+    TWeakObjectPtr<UWorld> ActorSpawnedWorld = nullptr;
 };
@@ -0,0 +1,28 @@
+/**
+ * @file RRROS2JointStatePublisher.h
+ * @brief JointState publisher class
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+
+// RapyutaSimulationPlugins
+#include "Tools/RRROS2BaseSensorPublisher.h"
+
+#include "RRROS2JointStatePublisher.generated.h"
+
+/**
+ * @brief JointState publisher class. Publishes data from #URRROS2JointStateSensorComponent
+ * @sa [sensor_msgs/JointState](http://docs.ros.org/en/noetic/api/sensor_msgs/html/msg/JointState.html)
+ */
+UCLASS(ClassGroup = (Custom), Blueprintable, meta = (BlueprintSpawnableComponent))
+class RAPYUTASIMULATIONPLUGINS_API URRROS2JointStatePublisher : public URRROS2BaseSensorPublisher
+{
+    GENERATED_BODY()
+
+public:
+    URRROS2JointStatePublisher();
+};
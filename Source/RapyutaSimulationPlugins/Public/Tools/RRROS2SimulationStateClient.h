@@ -16,6 +16,7 @@
 #include "Srvs/ROS2Attach.h"
 #include "Srvs/ROS2DeleteEntity.h"
 #include "Srvs/ROS2GetEntityState.h"
+#include "Srvs/ROS2SetBool.h"
 #include "Srvs/ROS2SetEntityState.h"
 #include "Srvs/ROS2SpawnEntities.h"
 #include "Srvs/ROS2SpawnEntity.h"
@@ -28,10 +29,11 @@
 
 class UROS2GenericSrv;
 class ASimulationState;
+enum class ERRRecordedCommandType : uint8;
 
 /**
  * @brief Provide ROS 2 interfaces to interact with UE4. This provide only ROS 2 interfaces and implementation is in #ASimulationState
- * Supported interactions: GetEntityState, SetEntityState, Attach, SpawnEntity, DeleteEntity
+ * Supported interactions: GetEntityState, SetEntityState, Attach, SpawnEntity, DeleteEntity, WorldCheckpoint
  *
  */
 UCLASS()
@@ -150,6 +152,23 @@ public:
     UFUNCTION(BlueprintCallable, Server, Reliable)
     void ServerDeleteEntity(const FROSDeleteEntityReq& InRequest);
 
+    /**
+     * @brief Callback function of WorldCheckpoint ROS 2 service.
+     * Save a checkpoint of all entities' states & sim clock if data is true, restore the saved one otherwise.
+     * @param InService
+     * @sa [example_interfaces/SetBool.srv](https://github.com/ros2/example_interfaces/blob/master/srv/SetBool.srv)
+     * @sa #ASimulationState::ServerSaveCheckpoint, #ASimulationState::ServerRestoreCheckpoint
+     */
+    UFUNCTION(BlueprintCallable)
+    void WorldCheckpointSrv(UROS2GenericSrv* InService);
+
+    /**
+     * @brief RPC call to Server's SaveCheckpoint/RestoreCheckpoint
+     * @param bInSave
+     */
+    UFUNCTION(BlueprintCallable, Server, Reliable)
+    void ServerWorldCheckpoint(const bool bInSave);
+
     /**
      * @brief RPC call to Server's AddEntity
      * @param InEntity
@@ -189,4 +208,22 @@ protected:
     bool CheckEntity(const FString& InEntityName, const bool bAllowEmpty = false);
     bool CheckSpawnableEntity(const FString& InEntityName, const bool bAllowEmpty = false);
     virtual FROSSpawnEntityRes SpawnEntityImpl(FROSSpawnEntityReq& InRequest);
+
+    /**
+     * @brief Record an inbound request with #URRCommandRecorder, if recording
+     * @param InType
+     * @param InRequest
+     * @param InNetworkPlayerId
+     * @return false while #URRCommandRecorder is replaying, during which live requests are ignored
+     */
+    template<typename TRequest>
+    bool ShouldApplyCommand(const ERRRecordedCommandType InType, const TRequest& InRequest, const int32 InNetworkPlayerId = 0);
+
+    /**
+     * @brief Save/Restore #ServerSimState's checkpoint, recording the request with #URRCommandRecorder. Must be run on server.
+     * @param bInSave
+     * @param OutMessage Result description
+     * @return Whether the checkpoint has been saved/restored
+     */
+    bool ApplyWorldCheckpoint(const bool bInSave, FString& OutMessage);
 };
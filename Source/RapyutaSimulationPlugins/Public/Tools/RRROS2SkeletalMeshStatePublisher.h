@@ -11,12 +11,14 @@
 // RapyutaSimulationPlugins
 #include "Robots/RobotVehicle.h"
 #include "Tools/RRROS2StatePublisher.h"
+#include "Tools/RRROS2TFPublisher.h"
 
 #include "RRROS2SkeletalMeshStatePublisher.generated.h"
 
 /**
- * @brief Publish pose of owner #ARobotVehicle which has skeletalmesh
- * 
+ * @brief Publish pose of owner #ARobotVehicle which has skeletalmesh.
+ * Optionally, with #bPublishBoneTF, also publishes transforms of #BoneNames' bones relative to #FrameId as a single /tf message.
+ * Bone indices are resolved once, then all bone transforms are read in one pass from the component space transforms.
  */
 UCLASS()
 class RAPYUTASIMULATIONPLUGINS_API URRROS2SkeletalMeshStatePublisher : public URRROS2StatePublisher
@@ -34,9 +36,42 @@ public:
      */
     void UpdateMessage(UROS2GenericMsg* InMessage) override;
 
+    /**
+     * @brief Create #BoneTFPublisher if #bPublishBoneTF in addition to Super::InitializeWithROS2()
+     *
+     * @param InROS2Node
+     */
+    bool InitializeWithROS2(UROS2NodeComponent* InROS2Node) override;
+
     UPROPERTY(VisibleAnywhere)
     USkeletalMeshComponent* SkeletalMeshComp = nullptr;
 
+    //! Publish bone transforms to /tf or not
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bPublishBoneTF = false;
+
+    //! Names of bones whose transforms are published. If empty, all bones are published.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FName> BoneNames;
+
+    //! Bone transforms publisher, updated by #UpdateBoneTFs & published in #UpdateMessage
+    UPROPERTY(BlueprintReadWrite)
+    URRROS2TFsPublisher* BoneTFPublisher = nullptr;
+
+    /**
+     * @brief Resolve #BoneIndices from #BoneNames and preallocate #BoneTFPublisher's transforms with their frame ids.
+     * Requires both #SkeletalMeshComp and #BoneTFPublisher.
+     * @return true if at least one bone has been resolved
+     */
+    UFUNCTION(BlueprintCallable)
+    bool InitBoneBuffer();
+
+    /**
+     * @brief Convert component space transforms of #BoneIndices' bones to ROS and write them to #BoneTFPublisher.
+     * @return false if there is no bone transform to publish
+     */
+    bool UpdateBoneTFs();
+
     //! Reference Actor
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
     AActor* Map = nullptr;
@@ -47,4 +82,9 @@ public:
      * @param InRobot 
      */
     void SetTargetRobot(ARobotVehicle* InRobot) override;
+
+protected:
+    //! Skeleton bone indices of published bones, in the same order as #BoneTFPublisher's transforms
+    UPROPERTY()
+    TArray<int32> BoneIndices;
 };
@@ -11,11 +11,13 @@
 
 // rclUE
 #include "Msgs/ROS2EntityState.h"
+#include "Msgs/ROS2TFMsg.h"
 #include "ROS2NodeComponent.h"
 #include "ROS2Publisher.h"
 
 // RapyutaSimulationPlugins
 #include "Robots/RobotVehicle.h"
+#include "Tools/RRROS2TFPublisher.h"
 
 #include "RRROS2StatePublisher.generated.h"
 
@@ -25,6 +27,8 @@
  * defined by multiple actors as well as robots defined by a skeletal mesh. This could use a refactor once the robots are more well
  * defined and could require a refactor of the main publisher class as well, to avoid the iterator Idx as it is used now Ideally, it
  * should be this class that fetches all the necessary data to be published.
+ * By default, one entry of #StatesToPublish is published per publish. With #bPublishAllStates, all entries are published as
+ * a single TF message per publish to #AllStatesTopicName instead, so each entity gets the full publication rate.
  * @todo Implementation should follow the other publisher classes.
  * @sa [UROS2Publisher](https://rclue.readthedocs.io/en/devel/doxygen_generated/html/d6/dd4/class_u_r_o_s2_publisher.html)
  */
@@ -36,6 +40,14 @@ class RAPYUTASIMULATIONPLUGINS_API URRROS2StatePublisher : public UROS2Publisher
 public:
     URRROS2StatePublisher();
 
+    /**
+     * @brief Create #AllStatesPublisher & start #AllStatesTimerHandle instead of this publisher's own loop if #bPublishAllStates,
+     * in addition to Super::InitializeWithROS2()
+     *
+     * @param InROS2Node
+     */
+    bool InitializeWithROS2(UROS2NodeComponent* InROS2Node) override;
+
     void UpdateMessage(UROS2GenericMsg* InMessage) override;
 
     UFUNCTION(BlueprintCallable)
@@ -60,4 +72,45 @@ public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FString ReferenceFrameId;
+
+    //! Publish all #StatesToPublish as a single TF message per publish to #AllStatesTopicName, instead of one entity per
+    //! publish to #TopicName. Must be set before InitializeWithROS2().
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bPublishAllStates = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString AllStatesTopicName = TEXT("states");
+
+    //! With #bPublishAllStates, skip entities whose pose has not changed since they were last published, and the whole publish
+    //! if none has
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bPublishOnlyChangedStates = false;
+
+    //! Position tolerance used by #bPublishOnlyChangedStates
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float ChangedPositionTolerance = 1.e-4f;
+
+    //! Orientation tolerance used by #bPublishOnlyChangedStates
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float ChangedOrientationTolerance = 1.e-4f;
+
+    //! Publisher of #bPublishAllStates mode, whose message buffer is reused
+    UPROPERTY(BlueprintReadOnly)
+    URRROS2TFsPublisher* AllStatesPublisher = nullptr;
+
+protected:
+    /**
+     * @brief Write all dirty #StatesToPublish into #AllStatesPublisher's message and publish it, unless there is none.
+     * Dirty flags are cleared afterwards.
+     */
+    void PublishAllStates();
+
+    FTimerHandle AllStatesTimerHandle;
+
+    //! Last published pose of each entry in #StatesToPublish, used by #bPublishOnlyChangedStates
+    UPROPERTY()
+    TArray<FROSPose> LastPublishedPoses;
+
+    //! Whether each entry in #StatesToPublish is to be published next
+    TBitArray<> DirtyStates;
 };
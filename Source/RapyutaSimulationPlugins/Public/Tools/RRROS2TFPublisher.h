@@ -1,6 +1,6 @@
 /**
  * @file RRROS2TFPublisher.h
- * @brief TF publisher class.
+ * @brief TF publisher classes.
  * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
  */
 
@@ -71,3 +71,53 @@ public:
      */
     void UpdateMessage(UROS2GenericMsg* InMessage) override;
 };
+
+/**
+ * @brief TF Publisher class which publishes multiple transforms in a single /tf message.
+ * #TFMsg is expected to be preallocated and updated by its owner, e.g. #URRROS2SkeletalMeshStatePublisher, which then either
+ * calls #PublishTFs right after updating it, with #PublicationFrequencyHz <= 0, or lets the publisher loop on its own timer.
+ * @sa [UROS2Publisher](https://rclue.readthedocs.io/en/devel/doxygen_generated/html/d6/dd4/class_u_r_o_s2_publisher.html)
+ */
+UCLASS(ClassGroup = (Custom), Blueprintable, meta = (BlueprintSpawnableComponent))
+class RAPYUTASIMULATIONPLUGINS_API URRROS2TFsPublisher : public UROS2Publisher
+{
+    GENERATED_BODY()
+
+public:
+    /**
+    * @brief Construct a new URRROS2TFsPublisher object
+    *
+    */
+    URRROS2TFsPublisher();
+
+    //! Publish static tf or not. @sa https://docs.ros.org/en/rolling/Tutorials/Tf2/Writing-A-Tf2-Static-Broadcaster-Cpp.html?highlight=static%20tf
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool IsStatic = false;
+
+    //! Publish to #TopicName as is, instead of /tf or /tf_static, e.g. for TF-typed non-TF data
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bKeepTopicName = false;
+
+    //! Transforms to publish, already converted to ROS
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FROSTFMsg TFMsg;
+
+    /**
+     * @brief Initialize publisher with QoS
+     *
+     * @param InROS2Node
+     */
+    bool InitializeWithROS2(UROS2NodeComponent* InROS2Node) override;
+
+    /**
+     * @brief Update message from #TFMsg.
+     *
+     * @param InMessage
+     */
+    void UpdateMessage(UROS2GenericMsg* InMessage) override;
+
+    /**
+     * @brief Publish #TFMsg right away, skipped if it is empty.
+     */
+    void PublishTFs();
+};
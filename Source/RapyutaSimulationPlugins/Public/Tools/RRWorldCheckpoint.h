@@ -0,0 +1,89 @@
+/**
+ * @file RRWorldCheckpoint.h
+ * @brief In-memory checkpoint of entities' states, restored without destroying or spawning actors
+ * @copyright Copyright 2020-2022 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+
+#include "RRWorldCheckpoint.generated.h"
+
+class URRJointComponent;
+
+/**
+ * @brief Compact binary checkpoint of entities' states, for fast episode resets instead of respawning entities or reloading the level.
+ * Per entity, it holds:
+ * - Actor transform, world transform & linear/angular velocities of its physics-simulating primitive components
+ * - Movement component's velocity & #URobotVehicleMovementComponent::AngularVelocity
+ * - #ARRBaseRobot's target velocities & its #URRJointComponent positions/velocities/targets
+ * - #URobotVehicleMovementComponent internal state, eg encoder pose, via #URobotVehicleMovementComponent::SerializeDriveState
+ * - #URRBaseOdomComponent internal state, ie odom origin, last poses & noise RNG, via #URRBaseOdomComponent::SerializeOdomState
+ *
+ * together with the world clock. Each entity's state is a size-prefixed block, so that entities removed or mismatching since
+ * capturing are skipped upon restoring.
+ * @sa #ASimulationState::ServerSaveCheckpoint, #ASimulationState::ServerRestoreCheckpoint
+ */
+USTRUCT(BlueprintType)
+struct RAPYUTASIMULATIONPLUGINS_API FRRWorldCheckpoint
+{
+    GENERATED_BODY()
+
+    static constexpr uint32 MAGIC = 0x52524350;    // "RRCP"
+    static constexpr uint32 VERSION = 2;
+
+    //! Serialized states
+    UPROPERTY()
+    TArray<uint8> Data;
+
+    //! Number of entities captured
+    UPROPERTY(BlueprintReadOnly)
+    int32 EntityNum = 0;
+
+    //! [s] World time upon capturing
+    UPROPERTY(BlueprintReadOnly)
+    double TimeSeconds = 0.0;
+
+    bool IsValid() const
+    {
+        return Data.Num() > 0;
+    }
+
+    void Reset()
+    {
+        Data.Reset();
+        EntityNum = 0;
+        TimeSeconds = 0.0;
+    }
+
+    /**
+     * @brief Capture states of entities & the world clock into #Data
+     * @param InWorld
+     * @param InEntities Name -> Entity, as #ASimulationState::Entities
+     * @return false if InWorld is null
+     */
+    bool Capture(UWorld* InWorld, const TMap<FString, AActor*>& InEntities);
+
+    /**
+     * @brief Apply captured states to entities of the same names, in a single pass
+     * @param InWorld
+     * @param InEntities Name -> Entity, as #ASimulationState::Entities
+     * @param bInRestoreClock Whether to also rewind the world clock, thus the sim time published to /clock
+     * @return Number of entities restored, INDEX_NONE if #Data is invalid
+     */
+    int32 Restore(UWorld* InWorld, const TMap<FString, AActor*>& InEntities, const bool bInRestoreClock = true) const;
+
+private:
+    /**
+     * @brief Save/load an entity's state block, applying it to the entity upon loading
+     * @param InOutAr
+     * @param InEntity
+     * @param bOutMatched false if the entity's components mismatch the block, which is then only partially read
+     * @param bInRestoreClock Whether the world clock is rewound too, otherwise odom times are moved to the current sim time
+     */
+    static void SerializeEntityState(FArchive& InOutAr, AActor* InEntity, bool& bOutMatched, const bool bInRestoreClock = true);
+
+    static void SerializeJointState(FArchive& InOutAr, URRJointComponent* InJoint);
+};
@@ -10,6 +10,7 @@
 // UE
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
 
 // rclUE
 #include "Srvs/ROS2Attach.h"
@@ -22,15 +23,19 @@
 // RapyutaSimulationPlugins
 #include "Core/RRConversionUtils.h"
 #include "Core/RRGeneralUtils.h"
+#include "Tools/RRWorldCheckpoint.h"
 
 #include "SimulationState.generated.h"
 
+class ARRBaseRobot;
+class ASimulationState;
+
 /**
  * @brief FRREntityInfo
- * This struct is used to create #SpawnableEntityInfoList
+ * This struct is used as a delta-replicated item of #ASimulationState::SpawnableEntityInfoList
  */
 USTRUCT()
-struct RAPYUTASIMULATIONPLUGINS_API FRREntityInfo
+struct RAPYUTASIMULATIONPLUGINS_API FRREntityInfo : public FFastArraySerializerItem
 {
     GENERATED_BODY()
 
@@ -47,6 +52,256 @@ struct RAPYUTASIMULATIONPLUGINS_API FRREntityInfo
         : EntityTypeName(InEntityInfo.Key), EntityClass(InEntityInfo.Value)
     {
     }
+
+    /**
+     * @brief Add this entity type to the owner's #ASimulationState::SpawnableEntityTypes on client
+     */
+    void PostReplicatedAdd(const struct FRREntityInfoList& InArraySerializer);
+
+    /**
+     * @brief Update this entity type's class in the owner's #ASimulationState::SpawnableEntityTypes on client
+     */
+    void PostReplicatedChange(const struct FRREntityInfoList& InArraySerializer);
+};
+
+/**
+ * @brief Delta-replicated list of #FRREntityInfo, so that only added entity types are sent to clients
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRREntityInfoList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FRREntityInfo> Items;
+
+    //! SimulationState owning this list, whose maps are updated upon item replication.
+    //! Not reflected so that it is never copied from an archetype, set in #ASimulationState::PostInitProperties instead.
+    ASimulationState* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FRREntityInfo, FRREntityInfoList>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FRREntityInfoList> : public TStructOpsTypeTraitsBase2<FRREntityInfoList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/**
+ * @brief Delta-replicated item of #ASimulationState::EntityList, holding a single entity
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRREntityListItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    AActor* Entity = nullptr;
+
+    FRREntityListItem()
+    {
+    }
+    FRREntityListItem(AActor* InEntity) : Entity(InEntity)
+    {
+    }
+
+    /**
+     * @brief Register #Entity to the owner's #ASimulationState::Entities & #ASimulationState::EntitiesWithTag on client
+     */
+    void PostReplicatedAdd(const struct FRREntityList& InArraySerializer);
+
+    /**
+     * @brief Register #Entity on client if it had not been resolved yet upon #PostReplicatedAdd
+     */
+    void PostReplicatedChange(const struct FRREntityList& InArraySerializer);
+
+    /**
+     * @brief Unregister #Entity from the owner's #ASimulationState::Entities & #ASimulationState::EntitiesWithTag on client
+     */
+    void PreReplicatedRemove(const struct FRREntityList& InArraySerializer);
+};
+
+/**
+ * @brief Delta-replicated list of entities, so that only added/removed entities are sent to clients,
+ * which then update only the affected entries of their maps.
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRREntityList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FRREntityListItem> Items;
+
+    //! SimulationState owning this list, whose maps are updated upon item replication.
+    //! Not reflected so that it is never copied from an archetype, set in #ASimulationState::PostInitProperties instead.
+    ASimulationState* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FRREntityListItem, FRREntityList>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FRREntityList> : public TStructOpsTypeTraitsBase2<FRREntityList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/**
+ * @brief Robot pose & velocity quantized for replication, with custom compact net serialization.
+ * Location & velocities are quantized by the precisions of #ASimulationState and serialized as packed integers,
+ * rotation as 16 bits per axis. In 2D mode, only X, Y, Yaw & their velocities are serialized.
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRRQuantizedRobotPose
+{
+    GENERATED_BODY()
+
+    //! Location, in location precision units
+    FIntVector Location = FIntVector::ZeroValue;
+
+    //! Rotation, compressed to 16 bits per axis
+    uint16 Pitch = 0;
+    uint16 Yaw = 0;
+    uint16 Roll = 0;
+
+    //! Local linear velocity, in velocity precision units
+    FIntVector LinearVel = FIntVector::ZeroValue;
+
+    //! Local angular velocity, in velocity precision units
+    FIntVector AngularVel = FIntVector::ZeroValue;
+
+    //! Whether only planar components are serialized
+    bool bIs2D = false;
+
+    /**
+     * @brief Quantize robot pose & velocities
+     * @param InTransform
+     * @param InLinearVel [cm/s]
+     * @param InAngularVel [deg/s]
+     * @param InLocationPrecision [cm]
+     * @param InVelocityPrecision [cm/s] & [deg/s]
+     * @param bInIs2D
+     */
+    void Quantize(const FTransform& InTransform,
+                  const FVector& InLinearVel,
+                  const FVector& InAngularVel,
+                  const float InLocationPrecision,
+                  const float InVelocityPrecision,
+                  const bool bInIs2D);
+
+    /**
+     * @brief Dequantize robot pose & velocities
+     * @param OutLocation [cm]
+     * @param OutRotation
+     * @param OutLinearVel [cm/s]
+     * @param OutAngularVel [deg/s]
+     * @param InLocationPrecision [cm]
+     * @param InVelocityPrecision [cm/s] & [deg/s]
+     */
+    void Dequantize(FVector& OutLocation,
+                    FRotator& OutRotation,
+                    FVector& OutLinearVel,
+                    FVector& OutAngularVel,
+                    const float InLocationPrecision,
+                    const float InVelocityPrecision) const;
+
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FRRQuantizedRobotPose& InOther) const
+    {
+        return (Location == InOther.Location) && (Pitch == InOther.Pitch) && (Yaw == InOther.Yaw) && (Roll == InOther.Roll) &&
+               (LinearVel == InOther.LinearVel) && (AngularVel == InOther.AngularVel) && (bIs2D == InOther.bIs2D);
+    }
+    bool operator!=(const FRRQuantizedRobotPose& InOther) const
+    {
+        return !(*this == InOther);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FRRQuantizedRobotPose> : public TStructOpsTypeTraitsBase2<FRRQuantizedRobotPose>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithIdenticalViaEquality = true,
+    };
+};
+
+/**
+ * @brief Delta-replicated item of #ASimulationState::RobotPoseList, holding a single robot's quantized pose
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRRRobotPoseItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    ARRBaseRobot* Robot = nullptr;
+
+    UPROPERTY()
+    FRRQuantizedRobotPose Pose;
+
+    FRRRobotPoseItem()
+    {
+    }
+    FRRRobotPoseItem(ARRBaseRobot* InRobot) : Robot(InRobot)
+    {
+    }
+
+    /**
+     * @brief Apply #Pose to #Robot on client
+     */
+    void PostReplicatedAdd(const struct FRRRobotPoseList& InArraySerializer);
+
+    /**
+     * @brief Apply #Pose to #Robot on client
+     */
+    void PostReplicatedChange(const struct FRRRobotPoseList& InArraySerializer);
+};
+
+/**
+ * @brief Fleet-level delta-replicated list of robot poses.
+ * Only robots whose quantized pose has changed are sent, all together in the owner's property bunch per net update.
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRRRobotPoseList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FRRRobotPoseItem> Items;
+
+    //! SimulationState owning this list, which applies replicated poses to robots.
+    //! Not reflected so that it is never copied from an archetype, set in #ASimulationState::PostInitProperties instead.
+    ASimulationState* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FRRRobotPoseItem, FRRRobotPoseList>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FRRRobotPoseList> : public TStructOpsTypeTraitsBase2<FRRRobotPoseList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
 };
 
 /**
@@ -88,6 +343,17 @@ public:
      */
     ASimulationState();
 
+    /**
+     * @brief Set the owner of delta-replicated lists, which is not copied from the archetype
+     */
+    virtual void PostInitProperties() override;
+
+    /**
+     * @brief Update #RobotPoseList on server if #bReplicateRobotPoses
+     * @param DeltaSeconds
+     */
+    virtual void Tick(float DeltaSeconds) override;
+
 public:
     /**
      * @brief Register entity types from Blueprint class names, that are configured in #ARRROS2GameMode
@@ -218,36 +484,95 @@ public:
     UPROPERTY(EditAnywhere)
     TMap<FName, FRREntities> EntitiesWithTag;
 
-    //! Replicatable copy of #Entities
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, ReplicatedUsing = OnRep_EntityList)
-    TArray<AActor*> EntityList;
+    //! Delta-replicated copy of #Entities, whose item callbacks update #Entities & #EntitiesWithTag on clients.
+    //! @note No longer a TArray<AActor*>, use #GetEntityList() to read it as such from Blueprints.
+    UPROPERTY(Replicated)
+    FRREntityList EntityList;
 
     /**
-     * @brief Callback when #EntityList is replicated
+     * @brief Get all entities in #EntityList
      */
     UFUNCTION(BlueprintCallable)
-    void OnRep_EntityList();
+    TArray<AActor*> GetEntityList() const;
+
+    /**
+     * @brief Register an entity replicated to client to #Entities & #EntitiesWithTag.
+     * It is keyed & renamed by its #UROS2Spawnable's name if it has one, and tagged with both its own & spawnable's tags.
+     * @param InEntity
+     */
+    void ClientAddEntity(AActor* InEntity);
+
+    /**
+     * @brief Unregister an entity from #Entities & its tag buckets in #EntitiesWithTag
+     * @param InEntity
+     */
+    void RemoveEntity(AActor* InEntity);
 
     //! Spawnable entity types for SpawnEntity ROS 2 service.
     //! @todo Converting to TArrays to be able to be replicated
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TMap<FString, TSubclassOf<AActor>> SpawnableEntityTypes;
 
-    //! Replicatable Copy of #SpawnableEntityTypes
-    UPROPERTY(EditAnywhere, ReplicatedUsing = OnRep_SpawnableEntityInfoList)
-    TArray<FRREntityInfo> SpawnableEntityInfoList;
+    //! Replicate poses of robots in #Entities via #RobotPoseList instead of their own movement replication,
+    //! which is disabled for them. Must be set before entities are added.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bReplicateRobotPoses = false;
+
+    //! Replicate only planar (X, Y, Yaw) robot poses & velocities
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated)
+    bool bReplicateRobotPoses2D = false;
+
+    //! Location quantization step of replicated robot poses [cm]
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated)
+    float RobotPoseLocationPrecision = 1.f;
+
+    //! Velocity quantization step of replicated robot poses [cm/s] & [deg/s]
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated)
+    float RobotPoseVelocityPrecision = 1.f;
+
+    //! Fleet-level delta-replicated robot poses, updated on server every tick but only sent per net update for changed ones
+    UPROPERTY(Replicated)
+    FRRRobotPoseList RobotPoseList;
 
     /**
-     * @brief Fetch #SpawnableEntityInfoList
+     * @brief Quantize poses of robots in #RobotPoseList & mark changed ones dirty
+     */
+    void ServerUpdateRobotPoses();
+
+    /**
+     * @brief Apply a replicated robot pose on client
+     * @param InItem
+     */
+    void ClientApplyRobotPose(const FRRRobotPoseItem& InItem);
+
+    /**
+     * @brief Capture states of all #Entities & the world clock into #Checkpoint on server
+     * @return false if not server
      */
     UFUNCTION(BlueprintCallable)
-    void GetSpawnableEntityInfoList();
+    bool ServerSaveCheckpoint();
 
     /**
-     * @brief Callback when #SpawnableEntityInfoList is replicated
+     * @brief Restore #Checkpoint to #Entities on server, without destroying or spawning any, for fast episode resets
+     * @param bInRestoreClock Whether to also rewind the world clock
+     * @return Number of entities restored, INDEX_NONE if no checkpoint has been saved or not server
      */
     UFUNCTION(BlueprintCallable)
-    void OnRep_SpawnableEntityInfoList();
+    int32 ServerRestoreCheckpoint(const bool bInRestoreClock = true);
+
+    //! Latest checkpoint saved by #ServerSaveCheckpoint. It could be also captured/restored from C++ with other entities.
+    UPROPERTY(BlueprintReadOnly)
+    FRRWorldCheckpoint Checkpoint;
+
+    //! Delta-replicated copy of #SpawnableEntityTypes, whose item callbacks update #SpawnableEntityTypes on clients
+    UPROPERTY(Replicated)
+    FRREntityInfoList SpawnableEntityInfoList;
+
+    /**
+     * @brief Add entity types of #SpawnableEntityTypes which are not yet in #SpawnableEntityInfoList
+     */
+    UFUNCTION(BlueprintCallable)
+    void GetSpawnableEntityInfoList();
 
     //! Timer handle to fetch #SpawnableEntityInfoList
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
@@ -260,6 +585,18 @@ public:
     TMap<FString, std::string> EncodedStrings;
 
 private:
+    /**
+     * @brief Add an entity to #EntitiesWithTag's InTag bucket, knowing that it is not there yet
+     */
+    void AddNewTaggedEntity(AActor* InEntity, const FName& InTag);
+
+    //! Entities registered to #Entities & #EntitiesWithTag, for O(1) duplication check
+    UPROPERTY()
+    TSet<AActor*> RegisteredEntities;
+
+    //! Entity type names already in #SpawnableEntityInfoList
+    TSet<FString> ReplicatedEntityTypeNames;
+
     /**
      * @brief Verify a function is called from server
      */
@@ -0,0 +1,120 @@
+/**
+ * @file RRRobotLabelsOverlay.h
+ * @brief Single screen overlay drawing all robots' labels
+ * @copyright Copyright 2020-2023 Rapyuta Robotics Co., Ltd.
+ */
+
+#pragma once
+
+// UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RRRobotLabelsOverlay.generated.h"
+
+class APlayerController;
+class UCanvas;
+class UFont;
+
+/**
+ * @brief On-screen label of an actor, drawn by #URRRobotLabelsOverlay
+ */
+USTRUCT()
+struct RAPYUTASIMULATIONPLUGINS_API FRRRobotLabel
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TWeakObjectPtr<AActor> Actor = nullptr;
+
+    //! World offset of the label from #Actor's location
+    UPROPERTY()
+    FVector Offset = FVector::ZeroVector;
+
+    UPROPERTY()
+    FText Text;
+
+    //! Whether the label text is visible, as toggled by #ARRBaseRobot::SetTooltipVisible
+    UPROPERTY()
+    bool bTextVisible = true;
+
+    //! Whether the whole label is visible, as toggled by #ARRBaseRobot::SetUIWidgetVisible
+    UPROPERTY()
+    bool bVisible = true;
+
+    //! Measured text size, only re-measured upon text change
+    FVector2D TextSize = FVector2D::ZeroVector;
+    bool bTextSizeDirty = true;
+};
+
+/**
+ * @brief Overlay drawing all registered actors' labels in a single canvas pass of the game viewport per frame, as opposed to
+ * one screen-space widget component & widget tree per robot.
+ * Each frame, labels are projected with a single view-projection matrix, culled outside of the view frustum or beyond
+ * #MaxLabelDistance, and their texts are only measured upon change.
+ * @sa [UDebugDrawService](https://docs.unrealengine.com/5.1/en-US/API/Runtime/Engine/Debug/UDebugDrawService/)
+ */
+UCLASS(config = RapyutaSimSettings)
+class RAPYUTASIMULATIONPLUGINS_API URRRobotLabelsOverlay : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //! [cm] Labels further from the view origin are not drawn, <= 0 for no limit
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    float MaxLabelDistance = 5000.f;
+
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite)
+    FLinearColor TextColor = FLinearColor::White;
+
+    virtual void Initialize(FSubsystemCollectionBase& InCollection) override;
+    virtual void Deinitialize() override;
+
+    /**
+     * @brief Add or update an actor's label
+     * @param InActor
+     * @param InText
+     * @param InOffset
+     */
+    void AddLabel(AActor* InActor, const FString& InText, const FVector& InOffset);
+
+    void RemoveLabel(const AActor* InActor);
+
+    bool HasLabel(const AActor* InActor) const
+    {
+        return LabelIndices.Contains(InActor);
+    }
+
+    void SetLabelText(const AActor* InActor, const FString& InText);
+    void SetLabelTextVisible(const AActor* InActor, bool bInTextVisible);
+    void SetLabelVisible(const AActor* InActor, bool bInVisible);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type InWorldType) const override
+    {
+        return (EWorldType::Game == InWorldType) || (EWorldType::PIE == InWorldType);
+    }
+
+    /**
+     * @brief Project, cull & draw all labels, registered to [UDebugDrawService] for the [Game] show flag
+     * @param InCanvas
+     * @param InPlayerController
+     */
+    void DrawLabels(UCanvas* InCanvas, APlayerController* InPlayerController);
+
+    FRRRobotLabel* FindLabel(const AActor* InActor);
+
+    UFUNCTION()
+    void OnLabelActorEndPlay(AActor* InActor, EEndPlayReason::Type InEndPlayReason);
+
+    //! Compact label list, of which indices are kept in #LabelIndices
+    UPROPERTY()
+    TArray<FRRRobotLabel> Labels;
+
+    TMap<const AActor*, int32> LabelIndices;
+
+    UPROPERTY()
+    TObjectPtr<UFont> Font = nullptr;
+
+    FDelegateHandle DrawHandle;
+};